@@ -0,0 +1,180 @@
+// Bitboard primitives: bit scans, population count and attack sets
+#include "chess-b.h"
+
+#ifndef __POPCNT__
+// KNUTH'S 2-ADIC FUNCTIONS, FOR FAST popcount()
+static const uint64_t K1 = (uint64_t)(0x5555555555555555); /*  -1/3   */
+static const uint64_t K2 = (uint64_t)(0x3333333333333333); /*  -1/5   */
+static const uint64_t K4 = (uint64_t)(0x0f0f0f0f0f0f0f0f); /*  -1/17  */
+static const uint64_t KF = (uint64_t)(0x0101010101010101); /*  -1/255 */
+
+/**
+ * @author: Donald Knuth
+ * (The Art of Computer Programming)
+ */
+static int popCountSoftware(uint64_t x) {
+	x =  x - ((x >> 1)  & K1); /* put count of each 2 bits into those 2 bits */
+  x = (x & K2) + ((x >> 2)  & K2); /* put count of each 4 bits into those 4 bits */
+  x = (x +  (x >> 4)) & K4 ; /* put count of each 8 bits into those 8 bits */
+  x = (x * KF) >> 56; /* returns 8 most significant bits of x + (x<<8) + (x<<16) + (x<<24) + ...  */
+  return (int) x;
+}
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__ELF__)
+__attribute__((target("popcnt")))
+static int popCountHardware(uint64_t x) {
+	return __builtin_popcountll(x);
+}
+
+// Run by the dynamic loader (or, statically linked, by the C library's
+// startup code) to bind popCount before main
+static int (*resolvePopCount(void))(uint64_t) {
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("popcnt") ? popCountHardware : popCountSoftware;
+}
+
+int popCount(uint64_t x) __attribute__((ifunc("resolvePopCount")));
+
+const char* popCountImplementation() {
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("popcnt") ? "popcnt (runtime)" : "software";
+}
+#else
+int popCount(uint64_t x) {
+	return popCountSoftware(x);
+}
+
+const char* popCountImplementation() {
+	return "software";
+}
+#endif
+#else
+const char* popCountImplementation() {
+	return "popcnt";
+}
+#endif
+
+uint64_t whitePawnAttacks(int square) {
+	// Also used for king squares, which can be on the last rank
+	if(square >= A8_INT) {
+		return 0;
+	}
+	switch(square % 8) {
+		case 0:
+			return SQUARE_BBS[square + 9];
+		case 1:
+		case 2:
+		case 3:
+		case 4:
+		case 5:
+		case 6:
+			return SQUARE_BBS[square + 9] | SQUARE_BBS[square + 7];
+		case 7:
+			return SQUARE_BBS[square + 7];
+	}
+	return 0;
+}
+
+uint64_t bishopAttacks(Position* p, int from) {
+	uint64_t attackedSquares = 0;
+	attackedSquares |= positiveRayAttacks(p->occupiedBB, DIR_NW, from);
+	attackedSquares |= positiveRayAttacks(p->occupiedBB, DIR_NE, from);
+	attackedSquares |= negativeRayAttacks(p->occupiedBB, DIR_SE, from);
+	attackedSquares |= negativeRayAttacks(p->occupiedBB, DIR_SW, from);
+	return attackedSquares;
+}
+
+uint64_t rookAttacks(Position* p, int from) {
+	uint64_t attackedSquares = 0;
+	attackedSquares |= positiveRayAttacks(p->occupiedBB, DIR_N, from);
+	attackedSquares |= positiveRayAttacks(p->occupiedBB, DIR_E, from);
+	attackedSquares |= negativeRayAttacks(p->occupiedBB, DIR_S, from);
+	attackedSquares |= negativeRayAttacks(p->occupiedBB, DIR_W, from);
+	return attackedSquares;
+}
+
+uint64_t queenAttacks(Position* p, int from) {
+	uint64_t attackedSquares = 0;
+	int i;
+	for(i=DIR_N; i<=DIR_NE; i++) {
+		attackedSquares |= positiveRayAttacks(p->occupiedBB, i, from);
+	}
+	for(i=DIR_S; i<=DIR_SW; i++) {
+		attackedSquares |= negativeRayAttacks(p->occupiedBB, i, from);
+	}
+	return attackedSquares;
+}
+
+uint64_t blackPawnAttacks(int square) {
+	if(square <= H1_INT) {
+		return 0;
+	}
+	switch(square % 8) {
+		case 0:
+			return SQUARE_BBS[square - 7];
+		case 1:
+		case 2:
+		case 3:
+		case 4:
+		case 5:
+		case 6:
+			return SQUARE_BBS[square - 9] | SQUARE_BBS[square - 7];
+		case 7:
+			return SQUARE_BBS[square - 9];
+	}
+	return 0;
+}
+
+int serialiseBoard(int* output, uint64_t pBB) {
+	int pCount, pLSB, prevBit;
+	pCount = prevBit = 0;
+	if(pBB) do {
+		pLSB = bitScanForward(pBB);
+		prevBit = output[pCount++] = pLSB + prevBit;
+		pBB >>= pLSB;
+	} while(pBB &= (pBB)-1);
+	return pCount;
+}
+
+// Based on https://www.chessprogramming.org/Classical_Approach
+uint64_t positiveRayAttacks(uint64_t occupied, int direction, int square) {
+	uint64_t attacks = RAY_ATTACK_ARRAYS[direction][square];
+	uint64_t blocker = attacks & occupied;
+	if(blocker) {
+		square = bitScanForward(blocker);
+		attacks ^= RAY_ATTACK_ARRAYS[direction][square];
+	}
+	return attacks;
+}
+
+uint64_t negativeRayAttacks(uint64_t occupied, int direction, int square) {
+	uint64_t attacks = RAY_ATTACK_ARRAYS[direction][square];
+	uint64_t blocker = attacks & occupied;
+	if(blocker) {
+		square = bitScanReverse(blocker);
+		attacks ^= RAY_ATTACK_ARRAYS[direction][square];
+	}
+	return attacks;
+}
+
+uint64_t northFill(uint64_t bb) {
+	bb |= (bb << 8);
+	bb |= (bb << 16);
+	bb |= (bb << 32);
+	return bb;
+}
+
+uint64_t southFill(uint64_t bb) {
+	bb |= (bb >> 8);
+	bb |= (bb >> 16);
+	bb |= (bb >> 32);
+	return bb;
+}
+
+uint64_t eastOne(uint64_t bb) {
+	return (bb << 1) & ~A_FILE;
+}
+
+uint64_t westOne(uint64_t bb) {
+	return (bb >> 1) & ~H_FILE;
+}
@@ -0,0 +1,812 @@
+// Internal interface of the chess-b engine, shared by the library sources,
+// the command line front end and microbench. Embedders use engine.h instead
+#ifndef CHESS_B_H
+#define CHESS_B_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/file.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+// Fast base 2 log (for converting bitboard->int)
+#define LOG2(X) ((unsigned) (8*sizeof (unsigned long long) - __builtin_clzll((X)) - 1))
+
+// Truth values
+#define FALSE 0
+#define TRUE 	1
+//Colours
+#define WHITE 0
+#define BLACK 1
+// Results
+#define RES_DRAW 					0
+#define RES_WHITE_WIN 		1
+#define RES_BLACK_WIN 		2
+
+#define RES_STALEMATE 		3
+#define RES_THREEFOLD  		4
+#define RES_FIFTY_MOVE 		5
+#define RES_UNFINISHED 		6
+#define RES_INSUFF_MATERIAL 7
+
+// Ai Modes
+#define NORMAL_AI 1
+#define DIRTY_AI 3
+#define IDS 2
+#define HUMAN 0
+
+// Nodes
+#define PV_NODE 0
+#define ALL_NODE 1
+#define CUT_NODE 2
+#define PV_NODE_CAPTURES 3
+#define ALL_NODE_CAPTURES 4
+#define CUT_NODE_CAPTURES 5
+#define EMPTY 6
+
+// Checkmate scores MATE_SCORE less the plies to mate. Anything beyond
+// MATE_BOUND is a mate
+#define MATE_SCORE 10000
+#define MAX_PLY 256
+#define MATE_BOUND (MATE_SCORE - MAX_PLY)
+
+// Quiet checks in quiescence: off, or the plies that try them
+#define QS_CHECKS_OFF -1
+#define QS_CHECK_PLIES 1
+
+// Move flags
+#define FLAG_QUIET_MOVE					 0
+#define FLAG_PAWN_PUSH 					(1<<0)
+#define FLAG_DOUBLE_PAWN_PUSH 	(1<<1)
+#define FLAG_KING_CASTLE				(1<<2)
+#define FLAG_QUEEN_CASTLE				(1<<3)
+#define FLAG_CAPTURES						(1<<4)
+#define FLAG_EP_CAPTURE					(1<<5)
+#define FLAG_PROMO							(1<<6)
+#define FLAG_KNIGHT_PROMO				(1<<7)
+#define FLAG_BISHOP_PROMO				(1<<8)
+#define FLAG_ROOK_PROMO					(1<<9)
+#define FLAG_QUEEN_PROMO				(1<<10)
+#define FLAG_KNIGHT_PROMO_CAPT	(1<<11)
+#define FLAG_BISHOP_PROMO_CAPT	(1<<12)
+#define FLAG_ROOK_PROMO_CAPT		(1<<13)
+#define FLAG_QUEEN_PROMO_CAPT		(1<<14)
+// Board flags
+#define W_KSIDE_CASTLE (1<<0)
+#define W_QSIDE_CASTLE (1<<1)
+#define B_KSIDE_CASTLE (1<<2)
+#define B_QSIDE_CASTLE (1<<3)
+
+// Pieces
+#define WHITE 		0
+#define BLACK			1
+#define W_PAWN 		2
+#define W_KNIGHT 	3
+#define W_BISHOP 	4
+#define W_ROOK 		5
+#define W_QUEEN 	6
+#define W_KING 		7
+#define B_PAWN 		8
+#define B_KNIGHT 	9
+#define B_BISHOP 	10
+#define B_ROOK 		11
+#define B_QUEEN 	12
+#define B_KING 		13
+
+// Packed middlegame/endgame score pairs. The endgame half lives in the upper
+// 16 bits, so pairs can be summed and negated as plain ints
+#define MAKE_SCORE(mg, eg) ((int)((unsigned int)(eg) << 16) + (mg))
+// Game phase: N/B = 1, R = 2, Q = 4, so 24 with all pieces on the board
+#define PHASE_TOTAL 24
+// The fifty move rule, in plies. Evaluation is scaled towards a draw over
+// its last plies, from FIFTY_MOVE_DAMPING_START on
+#define FIFTY_MOVE_PLIES 100
+#define FIFTY_MOVE_DAMPING_START 80
+
+// NNUE network shape. Inputs are one per (piece, square), seen from each side
+#define NNUE_INPUTS 768
+#define NNUE_HIDDEN 128
+#define NNUE_L2 32
+#define NNUE_VERSION 1
+// Hidden layer sums are shifted down by this before clipping
+#define NNUE_L2_SHIFT 6
+// Output divisor giving centipawns
+#define NNUE_OUTPUT_SCALE 64
+
+// Ray directions
+
+#define DIR_N 	0
+#define DIR_E		1
+#define DIR_NW	2
+#define DIR_NE	3
+#define DIR_S		4
+#define DIR_W		5
+#define DIR_SE	6
+#define DIR_SW	7
+
+
+// Square indices
+#define A1_INT 0
+#define B1_INT 1
+#define C1_INT 2
+#define D1_INT 3
+#define E1_INT 4
+#define F1_INT 5
+#define G1_INT 6
+#define H1_INT 7
+#define A2_INT 8
+#define B2_INT 9
+#define C2_INT 10
+#define D2_INT 11
+#define E2_INT 12
+#define F2_INT 13
+#define G2_INT 14
+#define H2_INT 15
+#define A3_INT 16
+#define B3_INT 17
+#define C3_INT 18
+#define D3_INT 19
+#define E3_INT 20
+#define F3_INT 21
+#define G3_INT 22
+#define H3_INT 23
+#define A4_INT 24
+#define B4_INT 25
+#define C4_INT 26
+#define D4_INT 27
+#define E4_INT 28
+#define F4_INT 29
+#define G4_INT 30
+#define H4_INT 31
+#define A5_INT 32
+#define B5_INT 33
+#define C5_INT 34
+#define D5_INT 35
+#define E5_INT 36
+#define F5_INT 37
+#define G5_INT 38
+#define H5_INT 39
+#define A6_INT 40
+#define B6_INT 41
+#define C6_INT 42
+#define D6_INT 43
+#define E6_INT 44
+#define F6_INT 45
+#define G6_INT 46
+#define H6_INT 47
+#define A7_INT 48
+#define B7_INT 49
+#define C7_INT 50
+#define D7_INT 51
+#define E7_INT 52
+#define F7_INT 53
+#define G7_INT 54
+#define H7_INT 55
+#define A8_INT 56
+#define B8_INT 57
+#define C8_INT 58
+#define D8_INT 59
+#define E8_INT 60
+#define F8_INT 61
+#define G8_INT 62
+#define H8_INT 63
+
+// Bitboard constants. Generated by gen.py
+static const uint64_t ONE64BIT = 1;
+static const uint64_t A1 = (ONE64BIT<<A1_INT);
+static const uint64_t B1 = (ONE64BIT<<B1_INT);
+static const uint64_t C1 = (ONE64BIT<<C1_INT);
+static const uint64_t D1 = (ONE64BIT<<D1_INT);
+static const uint64_t E1 = (ONE64BIT<<E1_INT);
+static const uint64_t F1 = (ONE64BIT<<F1_INT);
+static const uint64_t G1 = (ONE64BIT<<G1_INT);
+static const uint64_t H1 = (ONE64BIT<<H1_INT);
+static const uint64_t A2 = (ONE64BIT<<A2_INT);
+static const uint64_t B2 = (ONE64BIT<<B2_INT);
+static const uint64_t C2 = (ONE64BIT<<C2_INT);
+static const uint64_t D2 = (ONE64BIT<<D2_INT);
+static const uint64_t E2 = (ONE64BIT<<E2_INT);
+static const uint64_t F2 = (ONE64BIT<<F2_INT);
+static const uint64_t G2 = (ONE64BIT<<G2_INT);
+static const uint64_t H2 = (ONE64BIT<<H2_INT);
+static const uint64_t A3 = (ONE64BIT<<A3_INT);
+static const uint64_t B3 = (ONE64BIT<<B3_INT);
+static const uint64_t C3 = (ONE64BIT<<C3_INT);
+static const uint64_t D3 = (ONE64BIT<<D3_INT);
+static const uint64_t E3 = (ONE64BIT<<E3_INT);
+static const uint64_t F3 = (ONE64BIT<<F3_INT);
+static const uint64_t G3 = (ONE64BIT<<G3_INT);
+static const uint64_t H3 = (ONE64BIT<<H3_INT);
+static const uint64_t A4 = (ONE64BIT<<A4_INT);
+static const uint64_t B4 = (ONE64BIT<<B4_INT);
+static const uint64_t C4 = (ONE64BIT<<C4_INT);
+static const uint64_t D4 = (ONE64BIT<<D4_INT);
+static const uint64_t E4 = (ONE64BIT<<E4_INT);
+static const uint64_t F4 = (ONE64BIT<<F4_INT);
+static const uint64_t G4 = (ONE64BIT<<G4_INT);
+static const uint64_t H4 = (ONE64BIT<<H4_INT);
+static const uint64_t A5 = (ONE64BIT<<A5_INT);
+static const uint64_t B5 = (ONE64BIT<<B5_INT);
+static const uint64_t C5 = (ONE64BIT<<C5_INT);
+static const uint64_t D5 = (ONE64BIT<<D5_INT);
+static const uint64_t E5 = (ONE64BIT<<E5_INT);
+static const uint64_t F5 = (ONE64BIT<<F5_INT);
+static const uint64_t G5 = (ONE64BIT<<G5_INT);
+static const uint64_t H5 = (ONE64BIT<<H5_INT);
+static const uint64_t A6 = (ONE64BIT<<A6_INT);
+static const uint64_t B6 = (ONE64BIT<<B6_INT);
+static const uint64_t C6 = (ONE64BIT<<C6_INT);
+static const uint64_t D6 = (ONE64BIT<<D6_INT);
+static const uint64_t E6 = (ONE64BIT<<E6_INT);
+static const uint64_t F6 = (ONE64BIT<<F6_INT);
+static const uint64_t G6 = (ONE64BIT<<G6_INT);
+static const uint64_t H6 = (ONE64BIT<<H6_INT);
+static const uint64_t A7 = (ONE64BIT<<A7_INT);
+static const uint64_t B7 = (ONE64BIT<<B7_INT);
+static const uint64_t C7 = (ONE64BIT<<C7_INT);
+static const uint64_t D7 = (ONE64BIT<<D7_INT);
+static const uint64_t E7 = (ONE64BIT<<E7_INT);
+static const uint64_t F7 = (ONE64BIT<<F7_INT);
+static const uint64_t G7 = (ONE64BIT<<G7_INT);
+static const uint64_t H7 = (ONE64BIT<<H7_INT);
+static const uint64_t A8 = (ONE64BIT<<A8_INT);
+static const uint64_t B8 = (ONE64BIT<<B8_INT);
+static const uint64_t C8 = (ONE64BIT<<C8_INT);
+static const uint64_t D8 = (ONE64BIT<<D8_INT);
+static const uint64_t E8 = (ONE64BIT<<E8_INT);
+static const uint64_t F8 = (ONE64BIT<<F8_INT);
+static const uint64_t G8 = (ONE64BIT<<G8_INT);
+static const uint64_t H8 = (ONE64BIT<<H8_INT);
+
+static const uint64_t A_FILE = (A1|A2|A3|A4|A5|A6|A7|A8);
+static const uint64_t B_FILE = (B1|B2|B3|B4|B5|B6|B7|B8);
+static const uint64_t C_FILE = (C1|C2|C3|C4|C5|C6|C7|C8);
+static const uint64_t D_FILE = (D1|D2|D3|D4|D5|D6|D7|D8);
+static const uint64_t E_FILE = (E1|E2|E3|E4|E5|E6|E7|E8);
+static const uint64_t F_FILE = (F1|F2|F3|F4|F5|F6|F7|F8);
+static const uint64_t G_FILE = (G1|G2|G3|G4|G5|G6|G7|G8);
+static const uint64_t H_FILE = (H1|H2|H3|H4|H5|H6|H7|H8);
+
+static const uint64_t RANK_1 = (A1|B1|C1|D1|E1|F1|G1|H1);
+static const uint64_t RANK_2 = (A2|B2|C2|D2|E2|F2|G2|H2);
+static const uint64_t RANK_3 = (A3|B3|C3|D3|E3|F3|G3|H3);
+static const uint64_t RANK_4 = (A4|B4|C4|D4|E4|F4|G4|H4);
+static const uint64_t RANK_5 = (A5|B5|C5|D5|E5|F5|G5|H5);
+static const uint64_t RANK_6 = (A6|B6|C6|D6|E6|F6|G6|H6);
+static const uint64_t RANK_7 = (A7|B7|C7|D7|E7|F7|G7|H7);
+static const uint64_t RANK_8 = (A8|B8|C8|D8|E8|F8|G8|H8);
+
+static const uint64_t CENTRE_SQUARES = (D4|E4|D5|E5);
+static const uint64_t BIG_CENTRE_SQUARES = (RANK_3|RANK_4|RANK_5|RANK_6) & (C_FILE|D_FILE|E_FILE|F_FILE);
+static const uint64_t EDGE_SQUARES = (A_FILE | H_FILE | RANK_1 | RANK_8);
+
+static const uint64_t LIGHT_SQUARES = (B1|D1|F1|H1|A2|C2|E2|G2|B3|D3|F3|H3|A4|C4|E4|G4|B5|D5|F5|H5|A6|C6|E6|G6|B7|D7|F7|H7|A8|C8|E8|G8);
+static const uint64_t DARK_SQUARES = (A1|C1|E1|G1|B2|D2|F2|H2|A3|C3|E3|G3|B4|D4|F4|H4|A5|C5|E5|G5|B6|D6|F6|H6|A7|C7|E7|G7|B8|D8|F8|H8);
+
+static const uint64_t W_KSIDE_CASTLE_SQUARES = (E1|H1);
+static const uint64_t W_QSIDE_CASTLE_SQUARES = (E1|A1);
+static const uint64_t B_KSIDE_CASTLE_SQUARES = (E8|H8);
+static const uint64_t B_QSIDE_CASTLE_SQUARES = (E8|A8);
+static const uint64_t CASTLE_SQUARES = (A1|E1|H1|A8|E8|H8);
+
+
+// Lookup tables. gentables computes them at build time and prints them as
+// tables-data.c, so they are read-only data shared between processes. It
+// includes this header with GEN_TABLES defined, to fill them in
+#ifdef GEN_TABLES
+#define TABLE_CONST
+#else
+#define TABLE_CONST const
+#endif
+
+extern TABLE_CONST uint64_t SQUARE_BBS[64];
+extern TABLE_CONST uint64_t KNIGHT_ATTACKS[64];
+extern TABLE_CONST uint64_t KING_ATTACKS[64];
+extern TABLE_CONST uint64_t RAY_ATTACK_ARRAYS[8][64]; // By direction, then square
+extern TABLE_CONST uint64_t BETWEEN_BBS[64][64]; // Squares strictly between two on a line, else 0
+extern TABLE_CONST int PIECE_VALUES[14];
+extern TABLE_CONST int PIECE_VALUES_ABS[14];
+extern TABLE_CONST int PIECE_SQUARE_VALUES[14][64];
+extern TABLE_CONST int PHASE_VALUES[14];
+static const int MOBILITY_FACTOR = 1;
+extern TABLE_CONST int KING_ATTACK_WEIGHTS[14];
+extern TABLE_CONST int KING_SAFETY_TABLE[64]; // Middlegame penalty by attack units on king zone
+
+// For hashing positions
+#define ZOBRIST_LENGTH 781
+extern TABLE_CONST unsigned int ZOBRIST_RANDOMS[ZOBRIST_LENGTH];
+
+static const int HASH_TABLE_SIZE = 1<<16; // 65535
+static const int PAWN_HASH_TABLE_SIZE = 1<<12; // Must be a power of 2
+static const int EVAL_CACHE_DEFAULT_SIZE = 1<<16; // Entries, see --evalcache
+
+// Pawn structure terms (packed mg/eg)
+static const int DOUBLED_PAWN_PENALTY = MAKE_SCORE(-10, -20);
+static const int ISOLATED_PAWN_PENALTY = MAKE_SCORE(-10, -15);
+static const int BACKWARD_PAWN_PENALTY = MAKE_SCORE(-8, -10);
+
+// King safety terms (packed mg/eg), per pawn or file
+static const int PAWN_SHIELD_BONUS = MAKE_SCORE(12, 0);
+static const int PAWN_SHIELD_FAR_BONUS = MAKE_SCORE(6, 0);
+static const int KING_SEMI_OPEN_FILE_PENALTY = MAKE_SCORE(-15, 0);
+static const int KING_OPEN_FILE_PENALTY = MAKE_SCORE(-25, 0);
+extern TABLE_CONST int PASSED_PAWN_BONUS[8]; // By rank, relative to pawn's owner
+
+typedef struct {
+	unsigned int plyCount : 15;
+	unsigned int castlingFlags : 4;
+	unsigned int enPassantFlag : 6; // Square of capturable pawn
+} IrrFlag;
+
+typedef struct {
+	IrrFlag* list;
+	int used;
+	int size;
+} IrrFlagStack;
+
+typedef struct {
+	uint64_t pieceBB[14];
+	uint64_t emptyBB;
+	uint64_t occupiedBB;
+	unsigned int player : 1;
+	IrrFlag flag;
+	signed int squareValueTotal; // Packed mg/eg
+	signed int materialCount; // Packed mg/eg
+	signed int phase;
+	uint64_t squareAttacksBB[64];
+	unsigned int hash;
+	unsigned int pawnHash; // Zobrist hash of pawns only
+	struct Evaluator* evaluator;
+	// unsigned char attackedBySide[128];
+} Position;
+
+
+typedef struct {
+	unsigned int from : 6;
+	unsigned int to : 6;
+	unsigned int flags : 16;
+	unsigned int piece : 4;
+	unsigned int colour : 1;
+	unsigned int cPiece : 4;
+	unsigned int cColour : 1;
+} Move;
+
+typedef struct {
+	Move* list;
+	int used;
+	int size;
+} MoveList;
+
+typedef struct {
+	unsigned int key;
+	Move move;
+	unsigned int depth;
+	int score;
+	unsigned int nodeType : 3;
+} HashTableEntry;
+
+// typedef struct {
+// 	int key;
+// 	HashTableEntry value;
+// 	struct List* next;
+// } List;
+
+// Where a hash table's entries live, see initHashTable
+#define HASH_MEMORY_MALLOC 0
+#define HASH_MEMORY_HUGETLB 1
+#define HASH_MEMORY_THP 2
+#define HASH_MEMORY_FILE 3 // mapHashTable
+#define HASH_MEMORY_THP_REQUESTED 4 // madvise succeeded, but the kernel gave normal pages
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+// clearHashTable gives each thread at least this many entries, as below
+// that starting a thread costs more than it saves
+#define HASH_CLEAR_MIN_ENTRIES (1<<14)
+#define HASH_CLEAR_MAX_THREADS 64
+
+typedef struct {
+	HashTableEntry* array;
+	void* mapping; // Unmapped on free if not NULL
+	size_t mappingSize;
+	int memory;
+	int fd; // Of a file-backed table, holding its lock
+} HashTable;
+
+// Layout of a hash file: this header, then the entries exactly as they are
+// in memory, so files only move between builds with the same layout
+#define HASH_FILE_VERSION 2 // 2: entry depth is the draft searched, not the ply
+typedef struct {
+	char magic[4]; // "CCTT"
+	uint32_t version;
+	uint32_t keyScheme; // Checksum of ZOBRIST_RANDOMS
+	uint32_t entries;
+	uint32_t entrySize;
+	char padding[44];
+} HashTableFileHeader;
+
+typedef struct {
+	unsigned int key;
+	int score; // Packed mg/eg, from white's point of view
+} PawnHashEntry;
+
+typedef struct {
+	PawnHashEntry* array;
+} PawnHashTable;
+
+// Direct mapped. Key and score share one 64 bit word, so entries are read
+// and written atomically without locks
+typedef struct {
+	uint64_t* array;
+	unsigned int mask;
+} EvalCache;
+
+// Layout of a network file: this header, then in order the int16 feature
+// weights [NNUE_INPUTS][NNUE_HIDDEN] and biases, the int32 hidden biases,
+// int8 hidden weights [NNUE_L2][2*NNUE_HIDDEN], int32 output bias and int8
+// output weights. Everything is little-endian
+typedef struct {
+	char magic[4]; // "CCNN"
+	uint32_t version;
+	uint32_t inputs;
+	uint32_t hidden;
+	uint32_t l2;
+	char padding[44]; // Keeps the weights 64 byte aligned
+} NnueHeader;
+
+// Pointers into the memory-mapped network file
+typedef struct {
+	void* mapping;
+	size_t mappingSize;
+	const int16_t* featureWeights;
+	const int16_t* featureBiases;
+	const int32_t* l2Biases;
+	const int8_t* l2Weights;
+	const int32_t* outputBias;
+	const int8_t* outputWeights;
+} NnueNetwork;
+
+// Feature transformer output for both perspectives
+typedef struct {
+	int16_t values[2][NNUE_HIDDEN] __attribute__((aligned(32)));
+} NnueAccumulator;
+
+// One accumulator per ply, pushed by makeMove and popped by unmakeMove
+typedef struct {
+	NnueAccumulator* list;
+	int used;
+	int size;
+} NnueAccumulatorStack;
+
+// Mutable evaluation state, one per engine. Positions point to the evaluator
+// they are searched with, so eval and makeMove can reach it
+typedef struct Evaluator {
+	// Pawn structure rarely changes, so is cached across the whole game
+	PawnHashTable pawnHashTable;
+	EvalCache evalCache;
+	// Only used when a network is loaded, see loadEvaluatorNetwork()
+	int nnueEnabled;
+	NnueNetwork nnueNetwork;
+	NnueAccumulatorStack nnueStack;
+} Evaluator;
+
+// Counters for the search running on this thread. Nodes are always counted,
+// as bench needs them. The rest cost nothing unless built with -DCOLLECT_STATS
+typedef struct {
+	uint64_t nodes; // Including qnodes
+	uint64_t qnodes;
+	uint64_t ttProbes;
+	uint64_t ttHits;
+	uint64_t ttStores;
+	uint64_t ttOverwrites; // Stores replacing a different position
+	uint64_t betaCutoffs;
+	uint64_t firstMoveCutoffs;
+	int seldepth;
+	int rootPly; // fs->used at the root, so ply = fs->used - rootPly
+} SearchStats;
+
+extern __thread SearchStats SEARCH_STATS;
+
+// Cycles, instructions, branch misses, L1 data and last level cache misses
+#define PERF_COUNTER_COUNT 5
+typedef struct {
+	int fds[PERF_COUNTER_COUNT]; // -1 where the counter couldn't be opened
+	uint64_t values[PERF_COUNTER_COUNT];
+} PerfCounters;
+
+// Principal variation from the root. Lines longer than PV_MAX_PLY are cut
+#define PV_MAX_PLY 64
+typedef struct {
+	Move moves[PV_MAX_PLY];
+	int length;
+} PvLine;
+
+// Best line of the last completed iteration of the search on this thread
+extern __thread PvLine SEARCH_PV;
+
+// Lets another thread steer a search. stop ends it. infinite keeps it going
+// past its depth, while pondering or for go infinite, until cleared. The
+// search polls both every SEARCH_POLL_NODES nodes
+#define SEARCH_POLL_NODES 1024
+// Deepest iteration of an infinite search
+#define INFINITE_MAX_DEPTH 32
+typedef struct {
+	atomic_int stop;
+	atomic_int infinite;
+} SearchControl;
+
+// A search running on its own thread, see thread.c. The position and flag
+// stack are copies, so the caller's can change while it runs
+typedef struct {
+	pthread_t thread;
+	Position position;
+	IrrFlagStack flagStack;
+	HashTable* hashTable;
+	int depth;
+	int maxExtensions;
+	int quiescenceChecks;
+	int multiPV;
+	int uciOutput;
+	SearchControl control;
+	Move best;
+	PvLine pv;
+	int running; // Started and not yet joined
+} SearchThread;
+
+// Reports each completed iteration of iterativeDeepeningAI. score is from
+// white's point of view
+typedef void (*IterationCallback)(int depth, Move* best, int score, void* data);
+
+// Unpack the halves of a MAKE_SCORE pair
+static inline int mgScore(int score) {
+	return (int16_t)(uint16_t)(unsigned int)score;
+}
+
+static inline int egScore(int score) {
+	return (int16_t)(uint16_t)((unsigned int)(score + 0x8000) >> 16);
+}
+
+// Small, fast PRNG. The same seed always gives the same sequence
+static inline uint64_t xorshift64(uint64_t* state) {
+	*state ^= *state << 13;
+	*state ^= *state >> 7;
+	*state ^= *state << 17;
+	return *state;
+}
+
+// Bit scans, bb != 0. The builtins are BSF/BSR on any x86-64, and TZCNT/LZCNT
+// when built for a CPU with BMI1 (the default -march=native)
+static inline int bitScanForward(uint64_t bb) {
+	return __builtin_ctzll(bb);
+}
+
+static inline int bitScanReverse(uint64_t bb) {
+	return 63 - __builtin_clzll(bb);
+}
+
+// POPCNT isn't in the x86-64 baseline. Built for a CPU that has it, popCount
+// is the instruction. Otherwise (PORTABLE=1) bitboard.c picks an
+// implementation at load time, by asking the CPU
+#ifdef __POPCNT__
+static inline int popCount(uint64_t x) {
+	return __builtin_popcountll(x);
+}
+#endif
+
+#ifdef COLLECT_STATS
+#define STAT_INC(field) (SEARCH_STATS.field++)
+#define STAT_MAX(field, value) (SEARCH_STATS.field = (SEARCH_STATS.field > (value)) ? SEARCH_STATS.field : (value))
+#else
+#define STAT_INC(field) ((void) 0)
+#define STAT_MAX(field, value) ((void) 0)
+#endif
+
+// Functions, by the file defining them
+
+// bitboard.c
+#ifndef __POPCNT__
+int popCount(uint64_t x);
+#endif
+const char* popCountImplementation();
+uint64_t whitePawnAttacks(int square);
+uint64_t bishopAttacks(Position* p, int from);
+uint64_t rookAttacks(Position* p, int from);
+uint64_t queenAttacks(Position* p, int from);
+uint64_t blackPawnAttacks(int square);
+int serialiseBoard(int* output, uint64_t pBB);
+uint64_t positiveRayAttacks(uint64_t occupied, int direction, int square);
+uint64_t negativeRayAttacks(uint64_t occupied, int direction, int square);
+uint64_t northFill(uint64_t bb);
+uint64_t southFill(uint64_t bb);
+uint64_t eastOne(uint64_t bb);
+uint64_t westOne(uint64_t bb);
+
+// position.c
+void initIrrFlagStack(IrrFlagStack* fs, int initSize);
+void pushIrrFlagStack(IrrFlagStack* fs, Position* p);
+void pushIrrFlagStackReference(IrrFlagStack* fs, IrrFlag* b);
+IrrFlag popIrrFlagStack(IrrFlagStack* fs);
+void freeIrrFlagStack(IrrFlagStack* fs);
+char fileNumToChar(int f);
+char rankNumToChar(int r);
+void indexToAlgebraic(char* s, int ind);
+char playerToChar(int player);
+int squareToRank(int square);
+int squareToFile(int square);
+char pieceToChar(int piece);
+void moveToString(char* s, Move* m);
+void moveToUci(char* s, Move* m);
+int findUciMove(Position* p, IrrFlagStack* fs, const char* s, Move* m);
+void outputMove(Move* m, int full);
+void outputMoveList(MoveList* ml, char sep, int full);
+uint64_t getPieceBB(Position* pos, int p);
+uint64_t getEmptyBB(Position* pos);
+uint64_t getOccupiedBB(Position* pos);
+void genColourBBs(Position* pos);
+void genOcccupied(Position* pos);
+void setSquare(Position* pos, uint64_t square, int piece);
+void outputBitBoard(uint64_t bb);
+void outputAttackCounts(unsigned char* counts);
+void outputMeta(Position* p);
+void outputIrrFlag(IrrFlag flag);
+void outputPosition(Position* p);
+void outputAttackMaps(Position* p);
+void initialisePosition(Position* p, Evaluator* e);
+void updateZobristPieceMove(Position* p, int piece, int square);
+void updateZobristSideToMove(Position* p);
+void updateZobristWKCastle(Position* p);
+void updateZobristWQCastle(Position* p);
+void updateZobristBKCastle(Position* p);
+void updateZobristBQCastle(Position* p);
+void updateZobristCastlingFlag(Position* p, int flag);
+void updateZobristEnPassantFlag(Position* p, int flag);
+int calcZobristFromScratch(Position* p);
+int calcZobristFromScratchVerbose(Position* p);
+void initZobristHash(Position* p);
+int calcPhaseFromScratch(Position* p);
+int pieceOnSquare(Position* p, int square);
+uint64_t pieceAttacks(Position* p, int piece, int square);
+void genAllAttackMaps(Position* p);
+void setupStartPosition(Position* p, Evaluator* e);
+int setupPositionFromFen(Position* p, const char* fen, Evaluator* e);
+Move createMove(int from, int to, int flags, int piece, int colour, int cPiece, int cColour);
+unsigned int hashAfterMove(Position* p, Move* m);
+void makeMove(Position* p, Move* m, IrrFlagStack* fs);
+void unmakeMove(Position* p, Move* m, IrrFlagStack* fs);
+void verifyHash(Position* p, Move* m, int code);
+
+// movegen.c
+void initMoveList(MoveList* ml, int initSize);
+void insertMoveList(MoveList* ml, Move m);
+void insertMoveListReference(MoveList* ml, Move* m);
+Move* popMoveList(MoveList* ml);
+void pushMoveList(MoveList* ml, int from, int to, int flags, int piece, int colour, int cPiece, int cColour);
+void freeMoveList(MoveList* ml);
+void genWhiteCaptures(MoveList* ml, Position* p);
+void genBlackCaptures(MoveList* ml, Position* p);
+void genWhiteMoves(MoveList* ml, Position* p);
+void genBlackMoves(MoveList* ml, Position* p);
+void genEvasions(MoveList* ml, Position* p, uint64_t checkers);
+void genMoves(MoveList* ml, Position* p);
+uint64_t attackedByBlackBitBoard(Position* p, uint64_t bb);
+int attackedByBlack(Position* p, uint64_t bb);
+uint64_t attackedByWhiteBitBoard(Position* p, uint64_t bb);
+int attackedByWhite(Position* p, uint64_t bb);
+uint64_t attackersOf(Position* p, int square, int colour);
+uint64_t getCheckers(Position* p);
+void removalIllegalWhiteMoves(MoveList* ml, Position* p, IrrFlagStack* fs);
+void removalIllegalBlackMoves(MoveList* ml, Position* p, IrrFlagStack* fs);
+void genLegalMoves(MoveList* ml, Position* p, IrrFlagStack* fs);
+void genCaptures(MoveList* ml, Position* p, IrrFlagStack* fs);
+void genCapturesAndChecks(MoveList* ml, Position* p, IrrFlagStack* fs);
+int scoreFinalPosition(Position* p);
+int finalResult(Position* p);
+long perft(Position* b, IrrFlagStack* fs, int depth);
+
+// tt.c
+unsigned int calcHash(unsigned int hash32);
+void clearHashTable(HashTable* ht);
+void initHashTable(HashTable* ht, int hugePages);
+int mapHashTable(HashTable* ht, const char* path);
+const char* hashTableMemory(HashTable* ht);
+void addToHashTable(HashTable* ht, unsigned int key, Move m, int depth, int score, int nodeType);
+HashTableEntry* getFromHashTable(HashTable* ht, unsigned int key);
+// Starts loading key's entry into cache, ahead of getFromHashTable
+static inline void prefetchHashTable(HashTable* ht, unsigned int key) {
+	__builtin_prefetch(&ht->array[key % HASH_TABLE_SIZE]);
+}
+void freeHashTable(HashTable* ht);
+
+// eval.c
+void initPawnHashTable(PawnHashTable* pht);
+PawnHashEntry* getFromPawnHashTable(PawnHashTable* pht, unsigned int key);
+void freePawnHashTable(PawnHashTable* pht);
+void initEvalCache(EvalCache* ec, unsigned int size);
+int getFromEvalCache(EvalCache* ec, unsigned int key, int* score);
+void addToEvalCache(EvalCache* ec, unsigned int key, int score);
+void freeEvalCache(EvalCache* ec);
+int pawnStructureEval(uint64_t wPawns, uint64_t bPawns);
+int probePawnStructure(PawnHashTable* pht, Position* p);
+int pieceMobility(Position* p, int colour, int* kingAttackers, int* kingAttackUnits);
+int kingSafety(Position* p, int colour, int kingAttackers, int kingAttackUnits);
+int taperedScore(int score, int phase);
+int positionalEval(Position* p);
+int fiftyMoveScale(Position* p, int score);
+int staticEval(Position* p);
+int heuristicEval(Position* p);
+int cachedEval(Position* p);
+void initEvaluator(Evaluator* e, unsigned int evalCacheSize);
+int loadEvaluatorNetwork(Evaluator* e, const char* path);
+void refreshEvaluator(Evaluator* e, Position* p);
+void freeEvaluator(Evaluator* e);
+
+// nnue.c
+int loadNnueNetwork(NnueNetwork* net, const char* path);
+void freeNnueNetwork(NnueNetwork* net);
+int writeRandomNnueNetwork(const char* path, uint64_t seed);
+void nnueApplyDeltas(int16_t* dst, const int16_t* src, const int16_t** addRows, int adds, const int16_t** subRows, int subs);
+void nnueClippedRelu(uint8_t* output, const int16_t* input);
+void nnueHiddenLayer(int32_t* output, const uint8_t* input, const int8_t* weights, const int32_t* biases);
+const int16_t* nnueFeatureRow(const NnueNetwork* net, int perspective, int piece, int square);
+void initNnueStack(NnueAccumulatorStack* st, int initSize);
+void freeNnueStack(NnueAccumulatorStack* st);
+void refreshNnueStack(NnueAccumulatorStack* st, const NnueNetwork* net, Position* p);
+void pushNnueMove(NnueAccumulatorStack* st, const NnueNetwork* net, Position* p, Move* m);
+void popNnueMove(NnueAccumulatorStack* st);
+int nnueEval(Position* p);
+
+// search.c
+int dirtyAlphaBeta(Position* p, IrrFlagStack* fs, int depth, int maxExtensions, int alpha, int beta);
+void qsortMoveList(MoveList* ml, int* vals, int elements);
+void sortCapturesMVVLVA(MoveList* ml);
+void sortCapturesMVV(MoveList* ml);
+int quiescenceSearch(Position* p, IrrFlagStack* fs, int maxExtensions, int alpha, int beta);
+int alphaBeta(Position* p, IrrFlagStack* fs, int depth, int maxExtensions, int alpha, int beta, int capture);
+Move ai(Position* p, IrrFlagStack* fs, int depth, int aiMode, int maxExtensions, int verbose);
+void resetSearchStats(SearchStats* s);
+void addSearchStats(SearchStats* total, SearchStats* s);
+void outputSearchStats(SearchStats* s);
+void outputSearchInfo(int depth, int multiPV, int score, uint64_t nodes, uint64_t ms, PvLine* pv);
+int quiescenceSearchHash(Position* p, IrrFlagStack* fs, HashTable* ht, int depthSearched, int depth, int alpha, int beta, int checks);
+int iterativeDeepeningSearch(Position* p, IrrFlagStack* fs, HashTable* ht, int depthSearched, int depth, int maxExtensions, int quiescenceChecks, int alpha, int beta, int capture);
+Move iterativeDeepeningAI(Position* p, IrrFlagStack* fs, HashTable* ht, int maxDepth, int maxExtensions, int quiescenceChecks, int multiPV, int verbose, IterationCallback callback, void* data, SearchControl* control);
+
+// perf.c
+int openPerfCounters(PerfCounters* pc);
+void startPerfCounters(PerfCounters* pc);
+void stopPerfCounters(PerfCounters* pc);
+void outputPerfCounters(PerfCounters* pc, uint64_t nodes);
+void closePerfCounters(PerfCounters* pc);
+
+// bench.c
+extern const char* BENCH_FENS[];
+extern const int BENCH_FEN_COUNT;
+void bench(int depth, int maxExtensions, int quiescenceChecks, int hugePages, Evaluator* e, PerfCounters* pc);
+
+// thread.c
+void startSearchThread(SearchThread* st, Position* p, IrrFlagStack* fs, Evaluator* e, HashTable* ht, int depth, int maxExtensions, int quiescenceChecks, int multiPV, int infinite, int uciOutput);
+void ponderHit(SearchThread* st);
+void stopSearchThread(SearchThread* st);
+Move joinSearchThread(SearchThread* st);
+
+// uci.c
+void uciLoop(Evaluator* e, int quiescenceChecks, int hugePages, const char* hashFile);
+
+#endif
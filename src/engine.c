@@ -0,0 +1,132 @@
+// engine.h, implemented on the internal interface
+#include "chess-b.h"
+#include "engine.h"
+
+#define ENGINE_DEFAULT_DEPTH 4
+#define ENGINE_DEFAULT_EXTENSIONS 12
+
+struct Engine {
+	Position position;
+	IrrFlagStack flagStack;
+	HashTable hashTable;
+	Evaluator evaluator;
+};
+
+// Passed through iterativeDeepeningAI to reportIteration
+typedef struct {
+	Engine* engine;
+	EngineCallback callback;
+	void* userData;
+} SearchReport;
+
+Engine* engine_new(const EngineOptions* options) {
+	unsigned int evalCacheSize = EVAL_CACHE_DEFAULT_SIZE;
+	Engine* engine;
+
+	engine = malloc(sizeof(Engine));
+	if(engine == NULL) {
+		printf("ERROR: MALLOC FAILED\n"); return NULL;
+	}
+	if(options != NULL && options->evalCacheEntries > 0) {
+		evalCacheSize = options->evalCacheEntries;
+	}
+	initEvaluator(&engine->evaluator, evalCacheSize);
+	if(options != NULL && options->nnuePath != NULL && !loadEvaluatorNetwork(&engine->evaluator, options->nnuePath)) {
+		freeEvaluator(&engine->evaluator);
+		free(engine);
+		return NULL;
+	}
+	initIrrFlagStack(&engine->flagStack, 40);
+	if(options != NULL && options->hashFile != NULL) {
+		if(!mapHashTable(&engine->hashTable, options->hashFile)) {
+			freeIrrFlagStack(&engine->flagStack);
+			freeEvaluator(&engine->evaluator);
+			free(engine);
+			return NULL;
+		}
+	} else {
+		initHashTable(&engine->hashTable, options == NULL || !options->noHugePages);
+	}
+	setupStartPosition(&engine->position, &engine->evaluator);
+	return engine;
+}
+
+int engine_set_position(Engine* engine, const char* fen, const char* moves) {
+	Position p;
+	IrrFlagStack fs;
+	Move m;
+	char token[6];
+	int n;
+
+	if(fen == NULL || strcmp(fen, "startpos") == 0) {
+		setupStartPosition(&p, &engine->evaluator);
+	} else if(!setupPositionFromFen(&p, fen, &engine->evaluator)) {
+		return -1;
+	}
+
+	// Played on a copy, so that a bad move leaves the engine as it was
+	initIrrFlagStack(&fs, 40);
+	while(moves != NULL && sscanf(moves, " %5s%n", token, &n) == 1) {
+		moves += n;
+		if(!findUciMove(&p, &fs, token, &m)) {
+			freeIrrFlagStack(&fs);
+			return -1;
+		}
+		makeMove(&p, &m, &fs);
+	}
+
+	freeIrrFlagStack(&engine->flagStack);
+	engine->flagStack = fs;
+	engine->position = p;
+	refreshEvaluator(&engine->evaluator, &engine->position);
+	return 0;
+}
+
+static void reportIteration(int depth, Move* best, int score, void* data) {
+	SearchReport* report = data;
+	EngineInfo info;
+	info.depth = depth;
+	info.score = (report->engine->position.player == WHITE) ? score : -score;
+	info.nodes = SEARCH_STATS.nodes;
+	moveToUci(info.bestMove, best);
+	report->callback(&info, report->userData);
+}
+
+int engine_search(Engine* engine, const EngineLimits* limits, EngineCallback callback, void* userData, char* bestMove) {
+	int depth = ENGINE_DEFAULT_DEPTH;
+	int extensions = ENGINE_DEFAULT_EXTENSIONS;
+	int quiescenceChecks = FALSE;
+	SearchReport report;
+	MoveList ml;
+	Move m;
+
+	if(limits != NULL) {
+		depth = (limits->depth > 0) ? limits->depth : depth;
+		extensions = (limits->extensions >= 0) ? limits->extensions : extensions;
+		quiescenceChecks = (limits->quiescenceChecks != 0);
+	}
+	genLegalMoves(&ml, &engine->position, &engine->flagStack);
+	if(ml.used == 0) {
+		freeMoveList(&ml);
+		return -1;
+	}
+	freeMoveList(&ml);
+
+	report.engine = engine;
+	report.callback = callback;
+	report.userData = userData;
+	m = iterativeDeepeningAI(&engine->position, &engine->flagStack, &engine->hashTable, depth, extensions,
+		quiescenceChecks, 1, FALSE, (callback != NULL) ? reportIteration : NULL, &report, NULL);
+	moveToUci(bestMove, &m);
+	return 0;
+}
+
+void engine_free(Engine* engine) {
+	if(engine == NULL) {
+		return;
+	}
+	freeHashTable(&engine->hashTable);
+	freeIrrFlagStack(&engine->flagStack);
+	freeEvaluator(&engine->evaluator);
+	free(engine);
+}
@@ -0,0 +1,62 @@
+// Embedding API for the chess-b engine. Link against libchess-b.a or
+// libchess-b.so. Each Engine owns all of its mutable state (position,
+// transposition table, evaluation caches and network), so several engines
+// can be used at once, one thread per engine
+#ifndef CHESS_B_ENGINE_H
+#define CHESS_B_ENGINE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct Engine Engine;
+
+// Zeroed fields take the defaults
+typedef struct {
+	unsigned int evalCacheEntries; // Rounded down to a power of 2
+	const char* nnuePath; // Network to evaluate with, NULL for the handwritten eval
+	const char* hashFile; // Backs the hash table so it persists across runs, NULL for none. Locked to one process at a time
+	int noHugePages; // Non-zero to allocate the hash table with plain malloc rather than huge pages
+} EngineOptions;
+
+typedef struct {
+	int depth; // Iterative deepening stops after this depth. Default 4 if <= 0
+	int extensions; // Extra plies allowed for captures. Default 12 if < 0
+	int quiescenceChecks; // Non-zero to also try quiet checks at the first capture ply
+} EngineLimits;
+
+// Reported after each completed iteration of engine_search()
+typedef struct {
+	int depth;
+	int score; // Centipawns, from the side to move's point of view
+	uint64_t nodes; // Searched so far, including quiescence nodes
+	char bestMove[6]; // Long algebraic, e.g. e2e4 or e7e8q
+} EngineInfo;
+
+typedef void (*EngineCallback)(const EngineInfo* info, void* userData);
+
+// Returns NULL if options can't be satisfied (e.g. the network won't load,
+// or the hash file is in use).
+// options may be NULL
+Engine* engine_new(const EngineOptions* options);
+
+// fen is a FEN string or "startpos". moves, if not NULL, is a space separated
+// list of long algebraic moves played from it. Returns 0 on success, -1 if
+// the FEN or a move is invalid, in which case the position is unchanged
+int engine_set_position(Engine* engine, const char* fen, const char* moves);
+
+// Searches the current position, writing the best move (long algebraic) to
+// bestMove, which needs room for 6 chars. limits and callback may be NULL,
+// for the default limits and no reporting. Returns 0 on success, -1 if the
+// side to move has no legal moves
+int engine_search(Engine* engine, const EngineLimits* limits, EngineCallback callback, void* userData, char* bestMove);
+
+void engine_free(Engine* engine);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,270 @@
+// Handwritten evaluation and its caches
+#include "chess-b.h"
+
+void initPawnHashTable(PawnHashTable* pht) {
+	pht->array = malloc(PAWN_HASH_TABLE_SIZE * sizeof(PawnHashEntry));
+	if(pht->array == NULL) {
+		printf("ERROR: MALLOC FAILED\n"); return;
+	}
+	int i;
+	PawnHashEntry empty;
+	// Pawnless positions hash to 0 and score 0, so need no special case
+	empty.key = 0;
+	empty.score = 0;
+	for(i=0; i<PAWN_HASH_TABLE_SIZE; i++) {
+		pht->array[i] = empty;
+	}
+}
+
+PawnHashEntry* getFromPawnHashTable(PawnHashTable* pht, unsigned int key) {
+	return &pht->array[key & (PAWN_HASH_TABLE_SIZE - 1)];
+}
+
+void freePawnHashTable(PawnHashTable* pht) {
+	free(pht->array);
+}
+
+// Size is rounded down to a power of 2 entries
+void initEvalCache(EvalCache* ec, unsigned int size) {
+	unsigned int i;
+	size = (size > 0) ? (1u << LOG2(size)) : 1;
+	ec->array = malloc(size * sizeof(uint64_t));
+	if(ec->array == NULL) {
+		printf("ERROR: MALLOC FAILED\n"); return;
+	}
+	ec->mask = size - 1;
+	for(i=0; i<size; i++) {
+		ec->array[i] = 0;
+	}
+}
+
+// Returns TRUE and sets score on a hit
+int getFromEvalCache(EvalCache* ec, unsigned int key, int* score) {
+	uint64_t entry = ec->array[key & ec->mask];
+	if((unsigned int)(entry >> 32) != key) {
+		return FALSE;
+	}
+	*score = (int)(uint32_t) entry;
+	return TRUE;
+}
+
+void addToEvalCache(EvalCache* ec, unsigned int key, int score) {
+	ec->array[key & ec->mask] = ((uint64_t) key << 32) | (uint32_t) score;
+}
+
+void freeEvalCache(EvalCache* ec) {
+	free(ec->array);
+	ec->array = NULL;
+}
+
+// Packed mg/eg score of both sides' pawn structures, from white's point of view
+int pawnStructureEval(uint64_t wPawns, uint64_t bPawns) {
+	int i, score = 0;
+	int passedLocs[8];
+	int passedCount;
+
+	// Squares in front of each side's pawns, and those they will ever attack
+	uint64_t wFrontSpans = northFill(wPawns) << 8;
+	uint64_t bFrontSpans = southFill(bPawns) >> 8;
+	uint64_t wAttacks = eastOne(wPawns << 8) | westOne(wPawns << 8);
+	uint64_t bAttacks = eastOne(bPawns >> 8) | westOne(bPawns >> 8);
+	uint64_t wAttackSpans = northFill(wAttacks);
+	uint64_t bAttackSpans = southFill(bAttacks);
+	uint64_t wFiles = northFill(southFill(wPawns));
+	uint64_t bFiles = northFill(southFill(bPawns));
+
+	// Any pawn with a friendly pawn behind it
+	score += popCount(wPawns & wFrontSpans) * DOUBLED_PAWN_PENALTY;
+	score -= popCount(bPawns & bFrontSpans) * DOUBLED_PAWN_PENALTY;
+
+	// No friendly pawns on neighbouring files
+	score += popCount(wPawns & ~(eastOne(wFiles) | westOne(wFiles))) * ISOLATED_PAWN_PENALTY;
+	score -= popCount(bPawns & ~(eastOne(bFiles) | westOne(bFiles))) * ISOLATED_PAWN_PENALTY;
+
+	// Stop square controlled by an enemy pawn, and no friendly pawn can
+	// ever defend it
+	score += popCount(((wPawns << 8) & bAttacks & ~wAttackSpans) >> 8) * BACKWARD_PAWN_PENALTY;
+	score -= popCount(((bPawns >> 8) & wAttacks & ~bAttackSpans) << 8) * BACKWARD_PAWN_PENALTY;
+
+	// No enemy pawns ahead on the same or neighbouring files
+	passedCount = serialiseBoard(passedLocs, wPawns & ~(bFrontSpans | eastOne(bFrontSpans) | westOne(bFrontSpans)));
+	for(i=0; i<passedCount; i++) {
+		score += PASSED_PAWN_BONUS[passedLocs[i] / 8];
+	}
+	passedCount = serialiseBoard(passedLocs, bPawns & ~(wFrontSpans | eastOne(wFrontSpans) | westOne(wFrontSpans)));
+	for(i=0; i<passedCount; i++) {
+		score -= PASSED_PAWN_BONUS[7 - (passedLocs[i] / 8)];
+	}
+	return score;
+}
+
+int probePawnStructure(PawnHashTable* pht, Position* p) {
+	PawnHashEntry* entry = getFromPawnHashTable(pht, p->pawnHash);
+	if(entry->key != p->pawnHash) {
+		entry->key = p->pawnHash;
+		entry->score = pawnStructureEval(p->pieceBB[W_PAWN], p->pieceBB[B_PAWN]);
+	}
+	return entry->score;
+}
+
+// Number of squares attacked by colour's pieces. Attacks on the enemy king
+// zone are tallied on the same pass over the attack maps, for kingSafety()
+int pieceMobility(Position* p, int colour, int* kingAttackers, int* kingAttackUnits) {
+	int i, piece, square, count, total = 0;
+	int locs[10];
+	uint64_t attackBB, zoneAttacks;
+
+	uint64_t enemyKing = p->pieceBB[B_KING - (6*colour)];
+	uint64_t zone = KING_ATTACKS[LOG2(enemyKing)] | enemyKing;
+
+	*kingAttackers = *kingAttackUnits = 0;
+	for(piece=W_PAWN+(6*colour); piece<=W_KING+(6*colour); piece++) {
+		count = serialiseBoard(locs, p->pieceBB[piece]);
+		for(i=0; i<count; i++) {
+			square = locs[i];
+			// Slider maps go stale when other pieces move across their rays,
+			// so those are worked out afresh. p is only read
+			switch(piece) {
+				case W_BISHOP:
+				case B_BISHOP:
+					attackBB = bishopAttacks(p, square); break;
+				case W_ROOK:
+				case B_ROOK:
+					attackBB = rookAttacks(p, square); break;
+				case W_QUEEN:
+				case B_QUEEN:
+					attackBB = queenAttacks(p, square); break;
+				default:
+					attackBB = p->squareAttacksBB[square];
+			}
+			total += popCount(attackBB);
+			zoneAttacks = attackBB & zone;
+			if(zoneAttacks && KING_ATTACK_WEIGHTS[piece]) {
+				(*kingAttackers)++;
+				*kingAttackUnits += KING_ATTACK_WEIGHTS[piece] * popCount(zoneAttacks);
+			}
+		}
+	}
+	return total;
+}
+
+// Packed mg/eg safety of colour's king: attacks on its zone, pawn shield and
+// open files beside it. Negative is bad for colour
+int kingSafety(Position* p, int colour, int kingAttackers, int kingAttackUnits) {
+	int score = 0;
+	uint64_t king = p->pieceBB[W_KING+(6*colour)];
+	uint64_t pawns = p->pieceBB[W_PAWN+(6*colour)];
+	uint64_t allPawns = pawns | p->pieceBB[B_PAWN-(6*colour)];
+	uint64_t kingFiles = king | eastOne(king) | westOne(king);
+	uint64_t shield = (colour == WHITE) ? (kingFiles << 8) : (kingFiles >> 8);
+	uint64_t farShield = (colour == WHITE) ? (shield << 8) : (shield >> 8);
+
+	// A lone attacker is rarely dangerous
+	if(kingAttackers >= 2) {
+		score -= MAKE_SCORE(KING_SAFETY_TABLE[(kingAttackUnits < 64) ? kingAttackUnits : 63], 0);
+	}
+
+	score += popCount(shield & pawns) * PAWN_SHIELD_BONUS;
+	score += popCount(farShield & pawns) * PAWN_SHIELD_FAR_BONUS;
+
+	// Files on and beside the king, projected onto the first rank
+	kingFiles = southFill(northFill(kingFiles)) & RANK_1;
+	score += popCount(kingFiles & ~southFill(allPawns)) * KING_OPEN_FILE_PENALTY;
+	score += popCount(kingFiles & ~southFill(pawns) & southFill(allPawns)) * KING_SEMI_OPEN_FILE_PENALTY;
+	return score;
+}
+
+// Interpolate a packed mg/eg score by game phase
+int taperedScore(int score, int phase) {
+	if(phase > PHASE_TOTAL) {
+		phase = PHASE_TOTAL; // Early promotions
+	}
+	return (mgScore(score) * phase + egScore(score) * (PHASE_TOTAL - phase)) / PHASE_TOTAL;
+}
+
+// Evaluation of the pieces alone, so safe to cache by Zobrist hash
+int positionalEval(Position* p) {
+	// int i, score;
+	// score = 0;
+	// for(i=W_PAWN; i<=B_KING; i++) {
+	// 	score += popCount(p->pieceBB[i]) * PIECE_VALUES[i];
+	// }
+	int wKingAttackers, wKingAttackUnits, bKingAttackers, bKingAttackUnits;
+	int mobility = pieceMobility(p, WHITE, &bKingAttackers, &bKingAttackUnits);
+	mobility -= pieceMobility(p, BLACK, &wKingAttackers, &wKingAttackUnits);
+
+	int score = p->materialCount + p->squareValueTotal + probePawnStructure(&p->evaluator->pawnHashTable, p);
+	score += kingSafety(p, WHITE, wKingAttackers, wKingAttackUnits);
+	score -= kingSafety(p, BLACK, bKingAttackers, bKingAttackUnits);
+	score = taperedScore(score, p->phase);
+	score += mobility * MOBILITY_FACTOR;
+	return score;
+}
+
+// Drift towards a draw once the fifty move rule is close. Scores are left
+// alone until then, so quiet sequences aren't all worth less
+int fiftyMoveScale(Position* p, int score) {
+	int pliesLeft = FIFTY_MOVE_PLIES - (int) p->flag.plyCount;
+	if((int) p->flag.plyCount <= FIFTY_MOVE_DAMPING_START) {
+		return score;
+	}
+	return score * ((pliesLeft > 0) ? pliesLeft : 0) / (FIFTY_MOVE_PLIES - FIFTY_MOVE_DAMPING_START);
+}
+
+// The loaded network if there is one, otherwise the hand written terms
+int staticEval(Position* p) {
+	return p->evaluator->nnueEnabled ? nnueEval(p) : positionalEval(p);
+}
+
+int heuristicEval(Position* p) {
+	return fiftyMoveScale(p, staticEval(p));
+}
+
+// heuristicEval, but skipping the work for positions seen recently
+int cachedEval(Position* p) {
+	int score;
+	if(!getFromEvalCache(&p->evaluator->evalCache, p->hash, &score)) {
+		score = staticEval(p);
+		addToEvalCache(&p->evaluator->evalCache, p->hash, score);
+	}
+	return fiftyMoveScale(p, score);
+}
+
+void initEvaluator(Evaluator* e, unsigned int evalCacheSize) {
+	initPawnHashTable(&e->pawnHashTable);
+	initEvalCache(&e->evalCache, evalCacheSize);
+	e->nnueEnabled = FALSE;
+}
+
+// Switches e to network evaluation. Returns FALSE, leaving e as it was, if
+// the file can't be loaded
+int loadEvaluatorNetwork(Evaluator* e, const char* path) {
+	if(e->nnueEnabled) {
+		freeNnueNetwork(&e->nnueNetwork);
+		freeNnueStack(&e->nnueStack);
+		e->nnueEnabled = FALSE;
+	}
+	if(!loadNnueNetwork(&e->nnueNetwork, path)) {
+		return FALSE;
+	}
+	initNnueStack(&e->nnueStack, 64);
+	e->nnueEnabled = TRUE;
+	return TRUE;
+}
+
+// Call when p is set up other than by makeMove/unmakeMove
+void refreshEvaluator(Evaluator* e, Position* p) {
+	if(e->nnueEnabled) {
+		refreshNnueStack(&e->nnueStack, &e->nnueNetwork, p);
+	}
+}
+
+void freeEvaluator(Evaluator* e) {
+	freePawnHashTable(&e->pawnHashTable);
+	freeEvalCache(&e->evalCache);
+	if(e->nnueEnabled) {
+		freeNnueNetwork(&e->nnueNetwork);
+		freeNnueStack(&e->nnueStack);
+		e->nnueEnabled = FALSE;
+	}
+}
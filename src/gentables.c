@@ -0,0 +1,383 @@
+// Build step: computes the lookup tables and prints them as C source, so that
+// they are compiled into read-only data rather than built at startup. make
+// runs it as ./gentables > tables-data.c
+#define GEN_TABLES
+#include "chess-b.h"
+
+uint64_t SQUARE_BBS[64];
+uint64_t KNIGHT_ATTACKS[64];
+uint64_t KING_ATTACKS[64];
+uint64_t RAY_ATTACK_ARRAYS[8][64];
+uint64_t BETWEEN_BBS[64][64];
+int PIECE_VALUES[14];
+int PIECE_VALUES_ABS[14];
+int PIECE_SQUARE_VALUES[14][64];
+int PHASE_VALUES[14];
+int KING_ATTACK_WEIGHTS[14];
+int KING_SAFETY_TABLE[64]; // Middlegame penalty by attack units on king zone
+unsigned int ZOBRIST_RANDOMS[ZOBRIST_LENGTH];
+int PASSED_PAWN_BONUS[8]; // By rank, relative to pawn's owner
+
+static const int MAILBOX120[120] = {
+     -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+     -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+     -1,  0,  1,  2,  3,  4,  5,  6,  7, -1,
+     -1,  8,  9, 10, 11, 12, 13, 14, 15, -1,
+     -1, 16, 17, 18, 19, 20, 21, 22, 23, -1,
+     -1, 24, 25, 26, 27, 28, 29, 30, 31, -1,
+     -1, 32, 33, 34, 35, 36, 37, 38, 39, -1,
+     -1, 40, 41, 42, 43, 44, 45, 46, 47, -1,
+     -1, 48, 49, 50, 51, 52, 53, 54, 55, -1,
+     -1, 56, 57, 58, 59, 60, 61, 62, 63, -1,
+     -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+     -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+};
+
+static const int MAILBOX64[64] = {
+    21, 22, 23, 24, 25, 26, 27, 28,
+    31, 32, 33, 34, 35, 36, 37, 38,
+    41, 42, 43, 44, 45, 46, 47, 48,
+    51, 52, 53, 54, 55, 56, 57, 58,
+    61, 62, 63, 64, 65, 66, 67, 68,
+    71, 72, 73, 74, 75, 76, 77, 78,
+    81, 82, 83, 84, 85, 86, 87, 88,
+    91, 92, 93, 94, 95, 96, 97, 98
+};
+
+void computeTables() {
+	SQUARE_BBS[A1_INT] = A1;
+	SQUARE_BBS[B1_INT] = B1;
+	SQUARE_BBS[C1_INT] = C1;
+	SQUARE_BBS[D1_INT] = D1;
+	SQUARE_BBS[E1_INT] = E1;
+	SQUARE_BBS[F1_INT] = F1;
+	SQUARE_BBS[G1_INT] = G1;
+	SQUARE_BBS[H1_INT] = H1;
+	SQUARE_BBS[A2_INT] = A2;
+	SQUARE_BBS[B2_INT] = B2;
+	SQUARE_BBS[C2_INT] = C2;
+	SQUARE_BBS[D2_INT] = D2;
+	SQUARE_BBS[E2_INT] = E2;
+	SQUARE_BBS[F2_INT] = F2;
+	SQUARE_BBS[G2_INT] = G2;
+	SQUARE_BBS[H2_INT] = H2;
+	SQUARE_BBS[A3_INT] = A3;
+	SQUARE_BBS[B3_INT] = B3;
+	SQUARE_BBS[C3_INT] = C3;
+	SQUARE_BBS[D3_INT] = D3;
+	SQUARE_BBS[E3_INT] = E3;
+	SQUARE_BBS[F3_INT] = F3;
+	SQUARE_BBS[G3_INT] = G3;
+	SQUARE_BBS[H3_INT] = H3;
+	SQUARE_BBS[A4_INT] = A4;
+	SQUARE_BBS[B4_INT] = B4;
+	SQUARE_BBS[C4_INT] = C4;
+	SQUARE_BBS[D4_INT] = D4;
+	SQUARE_BBS[E4_INT] = E4;
+	SQUARE_BBS[F4_INT] = F4;
+	SQUARE_BBS[G4_INT] = G4;
+	SQUARE_BBS[H4_INT] = H4;
+	SQUARE_BBS[A5_INT] = A5;
+	SQUARE_BBS[B5_INT] = B5;
+	SQUARE_BBS[C5_INT] = C5;
+	SQUARE_BBS[D5_INT] = D5;
+	SQUARE_BBS[E5_INT] = E5;
+	SQUARE_BBS[F5_INT] = F5;
+	SQUARE_BBS[G5_INT] = G5;
+	SQUARE_BBS[H5_INT] = H5;
+	SQUARE_BBS[A6_INT] = A6;
+	SQUARE_BBS[B6_INT] = B6;
+	SQUARE_BBS[C6_INT] = C6;
+	SQUARE_BBS[D6_INT] = D6;
+	SQUARE_BBS[E6_INT] = E6;
+	SQUARE_BBS[F6_INT] = F6;
+	SQUARE_BBS[G6_INT] = G6;
+	SQUARE_BBS[H6_INT] = H6;
+	SQUARE_BBS[A7_INT] = A7;
+	SQUARE_BBS[B7_INT] = B7;
+	SQUARE_BBS[C7_INT] = C7;
+	SQUARE_BBS[D7_INT] = D7;
+	SQUARE_BBS[E7_INT] = E7;
+	SQUARE_BBS[F7_INT] = F7;
+	SQUARE_BBS[G7_INT] = G7;
+	SQUARE_BBS[H7_INT] = H7;
+	SQUARE_BBS[A8_INT] = A8;
+	SQUARE_BBS[B8_INT] = B8;
+	SQUARE_BBS[C8_INT] = C8;
+	SQUARE_BBS[D8_INT] = D8;
+	SQUARE_BBS[E8_INT] = E8;
+	SQUARE_BBS[F8_INT] = F8;
+	SQUARE_BBS[G8_INT] = G8;
+	SQUARE_BBS[H8_INT] = H8;
+
+	int knightJumps[8] = {-21,-19,-12,-8,8,12,19,21};
+	int i,j,dest;
+	uint64_t attackBB;
+	for(j=0; j<64; j++) {
+		attackBB = 0;
+		for(i=0; i<8; i++) {
+			dest = MAILBOX120[MAILBOX64[j] + knightJumps[i]];
+			if(dest >= 0) {
+				attackBB |= SQUARE_BBS[dest];
+			}
+		}
+		KNIGHT_ATTACKS[j] = attackBB;
+	}
+
+	int kingJumps[8] = {-11,-10,-9,-1,1,9,10,11};
+	for(j=0; j<64; j++) {
+		attackBB = 0;
+		for(i=0; i<8; i++) {
+			dest = MAILBOX120[MAILBOX64[j] + kingJumps[i]];
+			if(dest >= 0) {
+				attackBB |= SQUARE_BBS[dest];
+			}
+		}
+		KING_ATTACKS[j] = attackBB;
+	}
+
+	int ray_dirs[8] = {8, 1, 7, 9, -8, -1, -7, -9};
+	int dir, square, toSquare, file, rank, toFile, toRank, steps;
+	uint64_t board;
+	for(dir=0; dir<8; dir++) {
+		for(square=0; square<64; square++) {
+			board = 0;
+			file = square % 8;
+			rank = square / 8;
+			for(steps=1; steps<8; steps++) {
+				toSquare = square + (steps * ray_dirs[dir]);
+				if((toSquare < 0) || (toSquare > 63)) {
+					break;
+				}
+				toFile = toSquare % 8;
+				toRank = toSquare / 8;
+				if((abs(file - toFile) >= 7) || (abs(rank - toRank) >= 7)) {
+					break;
+				}
+				file = toFile;
+				rank = toRank;
+				board |= SQUARE_BBS[toSquare];
+			}
+			RAY_ATTACK_ARRAYS[dir][square] = board;
+		}
+	}
+
+	// A ray from one square, less the same ray from another square on it
+	for(dir=0; dir<8; dir++) {
+		for(square=0; square<64; square++) {
+			board = RAY_ATTACK_ARRAYS[dir][square];
+			for(toSquare=0; toSquare<64; toSquare++) {
+				if(board & SQUARE_BBS[toSquare]) {
+					BETWEEN_BBS[square][toSquare] = board & ~RAY_ATTACK_ARRAYS[dir][toSquare] & ~SQUARE_BBS[toSquare];
+				}
+			}
+		}
+	}
+
+	PIECE_VALUES[WHITE] = 0;
+	PIECE_VALUES[BLACK] = 0;
+	PIECE_VALUES[W_PAWN] = MAKE_SCORE(100, 120);
+	PIECE_VALUES[W_KNIGHT] = MAKE_SCORE(300, 280);
+	PIECE_VALUES[W_BISHOP] = MAKE_SCORE(325, 320);
+	PIECE_VALUES[W_ROOK] = MAKE_SCORE(500, 520);
+	PIECE_VALUES[W_QUEEN] = MAKE_SCORE(900, 920);
+	PIECE_VALUES[W_KING] = 0;
+	// Move ordering only needs the middlegame value
+	for(i=0; i<B_PAWN; i++) {
+		PIECE_VALUES_ABS[i] = mgScore(PIECE_VALUES[i]);
+	}
+	// Define black values symetrically
+	for(i=B_PAWN; i<=B_KING; i++) {
+		PIECE_VALUES[i] = -PIECE_VALUES[i-6];
+		PIECE_VALUES_ABS[i] = PIECE_VALUES_ABS[i-6];
+	}
+
+	for(i=0; i<14; i++) {
+		PHASE_VALUES[i] = 0;
+	}
+	PHASE_VALUES[W_KNIGHT] = PHASE_VALUES[B_KNIGHT] = 1;
+	PHASE_VALUES[W_BISHOP] = PHASE_VALUES[B_BISHOP] = 1;
+	PHASE_VALUES[W_ROOK] = PHASE_VALUES[B_ROOK] = 2;
+	PHASE_VALUES[W_QUEEN] = PHASE_VALUES[B_QUEEN] = 4;
+
+	for(i=0; i<14; i++) {
+		for(square=0; square<64; square++) {
+			PIECE_SQUARE_VALUES[i][square] = 0;
+		}
+	}
+
+	for(square=0; square<64; square++) {
+		board = SQUARE_BBS[square];
+		if(board & CENTRE_SQUARES) {
+			// Pawns best occupying centre
+			PIECE_SQUARE_VALUES[W_PAWN][square] += MAKE_SCORE(20, 5);
+			PIECE_SQUARE_VALUES[B_PAWN][square] += -MAKE_SCORE(20, 5);
+			// Centralise the king once the pieces come off
+			PIECE_SQUARE_VALUES[W_KING][square] += MAKE_SCORE(0, 30);
+			PIECE_SQUARE_VALUES[B_KING][square] += -MAKE_SCORE(0, 30);
+		} else if(board & BIG_CENTRE_SQUARES) {
+			PIECE_SQUARE_VALUES[W_PAWN][square] += MAKE_SCORE(5, 0);
+			PIECE_SQUARE_VALUES[B_PAWN][square] += -MAKE_SCORE(5, 0);
+			PIECE_SQUARE_VALUES[W_KNIGHT][square] += MAKE_SCORE(10, 10);
+			PIECE_SQUARE_VALUES[B_KNIGHT][square] += -MAKE_SCORE(10, 10);
+			PIECE_SQUARE_VALUES[W_KING][square] += MAKE_SCORE(0, 15);
+			PIECE_SQUARE_VALUES[B_KING][square] += -MAKE_SCORE(0, 15);
+			// Optimal squares for knights
+			if(square / 8 == 5) {
+				PIECE_SQUARE_VALUES[W_KNIGHT][square] += MAKE_SCORE(10, 10);
+			} else if(square / 8 == 2) {
+				PIECE_SQUARE_VALUES[B_KNIGHT][square] += -MAKE_SCORE(10, 10);
+			}
+		} else if(board & EDGE_SQUARES) {
+			// Stop running king up board in the middlegame, but keep it off the
+			// edge in the endgame
+			PIECE_SQUARE_VALUES[W_KING][square] += MAKE_SCORE(50, -30);
+			PIECE_SQUARE_VALUES[B_KING][square] += -MAKE_SCORE(50, -30);
+			// Knight on the rim is dim
+			PIECE_SQUARE_VALUES[W_KNIGHT][square] += MAKE_SCORE(-30, -30);
+			PIECE_SQUARE_VALUES[B_KNIGHT][square] += -MAKE_SCORE(-30, -30);
+			PIECE_SQUARE_VALUES[W_BISHOP][square] += MAKE_SCORE(-15, -15);
+			PIECE_SQUARE_VALUES[B_BISHOP][square] += -MAKE_SCORE(-15, -15);
+			PIECE_SQUARE_VALUES[W_QUEEN][square] += MAKE_SCORE(-5, -5);
+			PIECE_SQUARE_VALUES[B_QUEEN][square] += -MAKE_SCORE(-5, -5);
+		}
+		// Pawns gain value on 6th/7th ranks, more so in the endgame
+		switch(square / 8) {
+			case 1:
+				PIECE_SQUARE_VALUES[W_PAWN][square] += 0;
+				PIECE_SQUARE_VALUES[B_PAWN][square] += -MAKE_SCORE(40, 80); break;
+			case 2:
+				PIECE_SQUARE_VALUES[W_PAWN][square] += 0;
+				PIECE_SQUARE_VALUES[B_PAWN][square] += -MAKE_SCORE(15, 40); break;
+			case 3:
+				PIECE_SQUARE_VALUES[W_PAWN][square] += MAKE_SCORE(2, 5);
+				PIECE_SQUARE_VALUES[B_PAWN][square] += -MAKE_SCORE(5, 15); break;
+			case 4:
+				PIECE_SQUARE_VALUES[W_PAWN][square] += MAKE_SCORE(5, 15);
+				PIECE_SQUARE_VALUES[B_PAWN][square] += -MAKE_SCORE(2, 5); break;
+			case 5:
+				PIECE_SQUARE_VALUES[W_PAWN][square] += MAKE_SCORE(15, 40);
+				PIECE_SQUARE_VALUES[B_PAWN][square] += 0; break;
+			case 6:
+				PIECE_SQUARE_VALUES[W_PAWN][square] += MAKE_SCORE(40, 80);
+				PIECE_SQUARE_VALUES[B_PAWN][square] += 0; break;
+		}
+		switch(square % 8) {
+			case 0:
+			case 7:
+				PIECE_SQUARE_VALUES[W_PAWN][square] += MAKE_SCORE(-10, -5);
+				PIECE_SQUARE_VALUES[B_PAWN][square] += -MAKE_SCORE(-10, -5);
+		}
+	}
+	// Don't block development
+	PIECE_SQUARE_VALUES[W_PAWN][F2_INT] = MAKE_SCORE(10, 0);
+	PIECE_SQUARE_VALUES[B_PAWN][F7_INT] = -MAKE_SCORE(10, 0);
+	PIECE_SQUARE_VALUES[W_PAWN][E2_INT] = MAKE_SCORE(-20, 0);
+	PIECE_SQUARE_VALUES[B_PAWN][E7_INT] = -MAKE_SCORE(-20, 0);
+	PIECE_SQUARE_VALUES[W_PAWN][D2_INT] = MAKE_SCORE(-20, 0);
+	PIECE_SQUARE_VALUES[B_PAWN][D7_INT] = -MAKE_SCORE(-20, 0);
+
+	// On top of the pawn piece-square values
+	PASSED_PAWN_BONUS[0] = 0;
+	PASSED_PAWN_BONUS[1] = MAKE_SCORE(5, 10);
+	PASSED_PAWN_BONUS[2] = MAKE_SCORE(10, 20);
+	PASSED_PAWN_BONUS[3] = MAKE_SCORE(15, 35);
+	PASSED_PAWN_BONUS[4] = MAKE_SCORE(25, 60);
+	PASSED_PAWN_BONUS[5] = MAKE_SCORE(40, 100);
+	PASSED_PAWN_BONUS[6] = MAKE_SCORE(60, 150);
+	PASSED_PAWN_BONUS[7] = 0;
+
+	// Attack units per king zone square hit
+	for(i=0; i<14; i++) {
+		KING_ATTACK_WEIGHTS[i] = 0;
+	}
+	KING_ATTACK_WEIGHTS[W_KNIGHT] = KING_ATTACK_WEIGHTS[B_KNIGHT] = 2;
+	KING_ATTACK_WEIGHTS[W_BISHOP] = KING_ATTACK_WEIGHTS[B_BISHOP] = 2;
+	KING_ATTACK_WEIGHTS[W_ROOK] = KING_ATTACK_WEIGHTS[B_ROOK] = 3;
+	KING_ATTACK_WEIGHTS[W_QUEEN] = KING_ATTACK_WEIGHTS[B_QUEEN] = 5;
+	// Grows quadratically, so that co-ordinated attacks dominate
+	for(i=0; i<64; i++) {
+		KING_SAFETY_TABLE[i] = (i * i / 2 < 400) ? i * i / 2 : 400;
+	}
+
+	// Random Zobrist keys. Fixed seed, so that searches (and bench node
+	// counts) are reproducible between runs
+	uint64_t seed = 0x2545F4914F6CDD1DULL;
+	for(i=0; i<ZOBRIST_LENGTH; i++) {
+		ZOBRIST_RANDOMS[i] = (unsigned int) xorshift64(&seed);
+		// printf("%d\n", ZOBRIST_RANDOMS[i]);
+	}
+
+}
+
+// Initialiser rows, four 64 bit or eight 32 bit values per line
+void printU64s(const uint64_t* values, int n, const char* indent) {
+	int i;
+	for(i=0; i<n; i++) {
+		printf("%s0x%016" PRIx64 "ULL,%s", (i % 4 == 0) ? indent : "", values[i], (i % 4 == 3 || i == n-1) ? "\n" : " ");
+	}
+}
+
+void printInts(const int* values, int n, const char* indent) {
+	int i;
+	for(i=0; i<n; i++) {
+		printf("%s%d,%s", (i % 8 == 0) ? indent : "", values[i], (i % 8 == 7 || i == n-1) ? "\n" : " ");
+	}
+}
+
+void printUnsigneds(const unsigned int* values, int n, const char* indent) {
+	int i;
+	for(i=0; i<n; i++) {
+		printf("%s0x%08xu,%s", (i % 8 == 0) ? indent : "", values[i], (i % 8 == 7 || i == n-1) ? "\n" : " ");
+	}
+}
+
+int main() {
+	int i;
+	computeTables();
+
+	printf("// Generated by gentables.c, don't edit\n");
+	printf("#include \"chess-b.h\"\n\n");
+
+	printf("const uint64_t SQUARE_BBS[64] = {\n");
+	printU64s(SQUARE_BBS, 64, "\t");
+	printf("};\n\nconst uint64_t KNIGHT_ATTACKS[64] = {\n");
+	printU64s(KNIGHT_ATTACKS, 64, "\t");
+	printf("};\n\nconst uint64_t KING_ATTACKS[64] = {\n");
+	printU64s(KING_ATTACKS, 64, "\t");
+	printf("};\n\nconst uint64_t RAY_ATTACK_ARRAYS[8][64] = {\n");
+	for(i=0; i<8; i++) {
+		printf("\t{\n");
+		printU64s(RAY_ATTACK_ARRAYS[i], 64, "\t\t");
+		printf("\t},\n");
+	}
+	printf("};\n\nconst uint64_t BETWEEN_BBS[64][64] = {\n");
+	for(i=0; i<64; i++) {
+		printf("\t{\n");
+		printU64s(BETWEEN_BBS[i], 64, "\t\t");
+		printf("\t},\n");
+	}
+
+	printf("};\n\nconst int PIECE_VALUES[14] = {\n");
+	printInts(PIECE_VALUES, 14, "\t");
+	printf("};\n\nconst int PIECE_VALUES_ABS[14] = {\n");
+	printInts(PIECE_VALUES_ABS, 14, "\t");
+	printf("};\n\nconst int PIECE_SQUARE_VALUES[14][64] = {\n");
+	for(i=0; i<14; i++) {
+		printf("\t{\n");
+		printInts(PIECE_SQUARE_VALUES[i], 64, "\t\t");
+		printf("\t},\n");
+	}
+	printf("};\n\nconst int PHASE_VALUES[14] = {\n");
+	printInts(PHASE_VALUES, 14, "\t");
+	printf("};\n\nconst int KING_ATTACK_WEIGHTS[14] = {\n");
+	printInts(KING_ATTACK_WEIGHTS, 14, "\t");
+	printf("};\n\nconst int KING_SAFETY_TABLE[64] = {\n");
+	printInts(KING_SAFETY_TABLE, 64, "\t");
+	printf("};\n\nconst int PASSED_PAWN_BONUS[8] = {\n");
+	printInts(PASSED_PAWN_BONUS, 8, "\t");
+	printf("};\n\nconst unsigned int ZOBRIST_RANDOMS[ZOBRIST_LENGTH] = {\n");
+	printUnsigneds(ZOBRIST_RANDOMS, ZOBRIST_LENGTH, "\t");
+	printf("};\n");
+	return 0;
+}
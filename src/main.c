@@ -0,0 +1,553 @@
+// Command line front end: games, perft, bench and UCI
+#include "chess-b.h"
+
+// One evaluator serves every position the command line sets up
+Evaluator EVALUATOR;
+// Only used with --perf
+int PERF_ENABLED = FALSE;
+int QUIESCENCE_CHECKS = FALSE;
+// Cleared by --nohugepages, to compare hash tables on normal pages
+int HUGE_PAGES = TRUE;
+int PONDER = FALSE;
+PerfCounters PERF_COUNTERS;
+// Evaluation options, repeated for the evaluators of pondering searches
+unsigned int EVAL_CACHE_SIZE = EVAL_CACHE_DEFAULT_SIZE;
+const char* NNUE_PATH = NULL;
+// Only used with --hashfile, by uci
+const char* HASH_FILE = NULL;
+
+// With --ponder, an IDS player searches the position after the reply it
+// expects while its opponent thinks. It gets its own evaluator, as the
+// game's is in use meanwhile
+typedef struct {
+	SearchThread search;
+	Evaluator evaluator;
+	unsigned int hash; // Of the position being searched
+} Ponder;
+
+Move* inputPlayerMove(MoveList *ml) {
+	// char inp[6];
+	Move m;
+	int choice;
+	while(TRUE) {
+		printf("Choose a move:\n");
+		outputMoveList(ml, ' ', FALSE);
+		printf("\n> ");
+		scanf("%d", &choice);
+		choice--;
+		if(choice == -1) {
+			return NULL;
+		}
+		if(choice < 0 || choice >= ml->used) {
+			continue;
+		}
+		return &ml->list[choice];
+	}
+}
+
+void outputResult(int result) {
+	printf("GAMEOVER!\nRESULT: ");
+	switch(result) {
+		case RES_WHITE_WIN:
+			printf("White won by checkmate!\n"); break;
+		case RES_BLACK_WIN:
+			printf("Black won by checkmate!\n"); break;
+		case RES_STALEMATE:
+			printf("Draw by stalemate.\n"); break;
+		case RES_THREEFOLD:
+			printf("Draw by threefold repetition.\n"); break;
+		case RES_FIFTY_MOVE:
+			printf("Draw by fifty move rule.\n"); break;
+		case RES_INSUFF_MATERIAL:
+			printf("Draw by insufficient material.\n"); break;
+	}
+}
+
+// iterativeDeepeningAI, counting hardware events when verbose with --perf
+Move idsMove(Position* p, IrrFlagStack* fs, HashTable* ht, int depth, int maxExtensions, int verbose) {
+	Move m;
+	if(PERF_ENABLED && verbose) {
+		startPerfCounters(&PERF_COUNTERS);
+	}
+	m = iterativeDeepeningAI(p, fs, ht, depth, maxExtensions, QUIESCENCE_CHECKS, 1, verbose, NULL, NULL, NULL);
+	if(PERF_ENABLED && verbose) {
+		stopPerfCounters(&PERF_COUNTERS);
+		outputPerfCounters(&PERF_COUNTERS, SEARCH_STATS.nodes);
+	}
+	return m;
+}
+
+void initPonder(Ponder* ponder) {
+	ponder->search.running = FALSE;
+	initEvaluator(&ponder->evaluator, EVAL_CACHE_SIZE);
+	if(NNUE_PATH != NULL) {
+		loadEvaluatorNetwork(&ponder->evaluator, NNUE_PATH);
+	}
+}
+
+void freePonder(Ponder* ponder) {
+	if(ponder->search.running) {
+		stopSearchThread(&ponder->search);
+		joinSearchThread(&ponder->search);
+	}
+	freeEvaluator(&ponder->evaluator);
+}
+
+// Called after an IDS player's move, with pv the line it expects. Ponders
+// the position after the reply, unless that ends the game. The search
+// stops at the player's own depth, as the move it would play is known by
+// then, so it doesn't keep a CPU busy through a long think by the opponent
+void startPonder(Ponder* ponder, Position* p, IrrFlagStack* fs, HashTable* ht, PvLine* pv, int depth, int maxExtensions) {
+	MoveList ml;
+	Move reply;
+	if(pv->length < 2) {
+		return;
+	}
+	reply = pv->moves[1];
+	makeMove(p, &reply, fs);
+	genLegalMoves(&ml, p, fs);
+	if(ml.used > 0) {
+		ponder->hash = p->hash;
+		startSearchThread(&ponder->search, p, fs, &ponder->evaluator, ht, depth, maxExtensions, QUIESCENCE_CHECKS, 1, FALSE, FALSE);
+	}
+	freeMoveList(&ml);
+	unmakeMove(p, &reply, fs);
+}
+
+// An IDS player's move, with its expected line in pv. If it pondered the
+// reply that was played, that search gives the move once it reaches depth.
+// Otherwise it's stopped here, as soon as the opponent has moved
+Move idsPlayerMove(Ponder* ponder, Position* p, IrrFlagStack* fs, HashTable* ht, int depth, int maxExtensions, int verbose, PvLine* pv) {
+	Move m;
+	if(ponder->search.running) {
+		if(p->hash == ponder->hash) {
+			ponderHit(&ponder->search);
+			m = joinSearchThread(&ponder->search);
+			*pv = ponder->search.pv;
+			printf("Ponder hit\n");
+			return m;
+		}
+		stopSearchThread(&ponder->search);
+		joinSearchThread(&ponder->search);
+	}
+	m = idsMove(p, fs, ht, depth, maxExtensions, verbose);
+	*pv = SEARCH_PV;
+	return m;
+}
+
+int playGame(int player1, int player2, int depth1, int maxExtensions1, int depth2, int maxExtensions2, int verbose) {
+	Position p;
+	setupStartPosition(&p, &EVALUATOR);
+	IrrFlagStack fs;
+	initIrrFlagStack(&fs, 40);
+
+	Move playerMove;
+	Move* inp;
+	MoveList legalMoves;
+	MoveList history;
+	// MoveList captures;
+	initMoveList(&history, 40);
+	int result = 0;
+	int mover, i;
+	PvLine pv;
+
+	// Per colour, so that a pondering search keeps its own TT
+	HashTable ht[2];
+	Ponder ponders[2];
+	for(i=0; i<2; i++) {
+		initHashTable(&ht[i], HUGE_PAGES);
+		if(PONDER) {
+			initPonder(&ponders[i]);
+		}
+	}
+
+
+	while(TRUE) {
+
+		// outputAttackMaps(&p);
+		genLegalMoves(&legalMoves, &p, &fs);
+		outputPosition(&p);
+		sortCapturesMVV(&legalMoves);
+
+		if(legalMoves.used == 0) {
+			result = finalResult(&p);
+			break;
+		}
+		if(p.flag.plyCount >= FIFTY_MOVE_PLIES) {
+			result = RES_FIFTY_MOVE;
+			break;
+		}
+		// TODO
+		// if(detectThreefold(bs) || detectInsufficientMaterial(&b)) {
+		// 	result = ...;
+		// 	break;
+		// }
+		if((p.player == WHITE && player1 == HUMAN) || (p.player == BLACK && player2 == HUMAN)) {
+			do {
+				do {
+					inp = inputPlayerMove(&legalMoves);
+				} while(inp == NULL && (history.used == 0));
+				if(inp == NULL) {
+					unmakeMove(&p, popMoveList(&history), &fs);
+					genLegalMoves(&legalMoves, &p, &fs);
+					sortCapturesMVV(&legalMoves);
+					outputPosition(&p);
+				} else {
+					playerMove = *inp;
+				}
+			} while(inp == NULL);
+
+		} else if(p.player == WHITE) {
+			printf("Thinking...\n");
+
+			if(player1 == IDS) {
+				playerMove = PONDER ? idsPlayerMove(&ponders[WHITE], &p, &fs, &ht[WHITE], depth1, maxExtensions1, verbose, &pv)
+					: idsMove(&p, &fs, &ht[WHITE], depth1, maxExtensions1, verbose);
+			} else {
+				playerMove = ai(&p, &fs, depth1, player1, maxExtensions1, verbose);
+			}
+
+			printf("Computer moves: ");
+			outputMove(&playerMove, FALSE);
+			printf("\n");
+
+		} else {
+			printf("Thinking...\n");
+
+			if(player2 == IDS) {
+				playerMove = PONDER ? idsPlayerMove(&ponders[BLACK], &p, &fs, &ht[BLACK], depth2, maxExtensions2, verbose, &pv)
+					: idsMove(&p, &fs, &ht[BLACK], depth2, maxExtensions2, verbose);
+			} else {
+				playerMove = ai(&p, &fs, depth2, player2, maxExtensions2, verbose);
+			}
+
+
+			printf("Computer moves: ");
+			outputMove(&playerMove, FALSE);
+			printf("\n");
+		}
+		mover = p.player;
+		insertMoveList(&history, playerMove);
+		makeMove(&p, &playerMove, &fs);
+		if(PONDER && mover == WHITE && player1 == IDS) {
+			startPonder(&ponders[WHITE], &p, &fs, &ht[WHITE], &pv, depth1, maxExtensions1);
+		} else if(PONDER && mover == BLACK && player2 == IDS) {
+			startPonder(&ponders[BLACK], &p, &fs, &ht[BLACK], &pv, depth2, maxExtensions2);
+		}
+
+		// freeMoveList(&legalMoves);
+	}
+
+	outputResult(result);
+	freeMoveList(&legalMoves);
+	freeMoveList(&history);
+
+	for(i=0; i<2; i++) {
+		if(PONDER) {
+			freePonder(&ponders[i]);
+		}
+		freeHashTable(&ht[i]);
+	}
+
+
+	return result;
+}
+
+void testPosition() {
+	Position p;
+	IrrFlagStack fs;
+	initIrrFlagStack(&fs, 10);
+
+	setupStartPosition(&p, &EVALUATOR);
+	pushIrrFlagStack(&fs, &p);
+	IrrFlag f = popIrrFlagStack(&fs);
+	outputIrrFlag(f);
+
+	outputPosition(&p);
+
+	Move e4 = createMove(E2_INT, E4_INT, FLAG_DOUBLE_PAWN_PUSH, W_PAWN, WHITE, 0, 0);
+	makeMove(&p, &e4, &fs);
+	outputPosition(&p);
+	Move e5 = createMove(E7_INT, E5_INT, FLAG_DOUBLE_PAWN_PUSH, B_PAWN, BLACK, 0, 0);
+	makeMove(&p, &e5, &fs);
+	outputPosition(&p);
+	Move nf3 = createMove(G1_INT, F3_INT, FLAG_QUIET_MOVE, W_KNIGHT, WHITE, 0, 0);
+	makeMove(&p, &nf3, &fs);
+	outputPosition(&p);
+	Move nf6 = createMove(G8_INT, F6_INT, FLAG_QUIET_MOVE, B_KNIGHT, BLACK, 0, 0);
+	makeMove(&p, &nf6, &fs);
+	outputPosition(&p);
+	Move bc4 = createMove(F1_INT, C4_INT, FLAG_QUIET_MOVE, W_BISHOP, WHITE, 0, 0);
+	makeMove(&p, &bc4, &fs);
+	outputPosition(&p);
+	Move bc5 = createMove(F8_INT, C5_INT, FLAG_QUIET_MOVE, B_BISHOP, BLACK, 0, 0);
+	makeMove(&p, &bc5, &fs);
+	outputPosition(&p);
+	Move wc = createMove(E1_INT, G1_INT, FLAG_KING_CASTLE, W_KING, WHITE, 0, 0);
+	makeMove(&p, &wc, &fs);
+	outputPosition(&p);
+
+	printf("Eval: %d\n", heuristicEval(&p));
+
+	Move bc = createMove(E8_INT, G8_INT, FLAG_KING_CASTLE, B_KING, BLACK, 0, 0);
+	makeMove(&p, &bc, &fs);
+	outputPosition(&p);
+
+	printf("Eval: %d\n", heuristicEval(&p));
+
+	freeIrrFlagStack(&fs);
+
+}
+
+void testMove() {
+	Move m;
+	m.from = 61;
+	m.to = 33;
+	m.flags = 15;
+	printf("%d %d %d\n", m.from, m.to, m.flags);
+}
+
+void testMoveGen() {
+	Position p;
+	IrrFlagStack fs;
+	MoveList ml;
+	initIrrFlagStack(&fs, 10);
+	setupStartPosition(&p, &EVALUATOR);
+	pushIrrFlagStack(&fs, &p);
+
+	outputPosition(&p);
+	genMoves(&ml, &p);
+	outputMoveList(&ml, '\n', FALSE);
+
+	Move e4 = createMove(E2_INT, E4_INT, FLAG_DOUBLE_PAWN_PUSH, W_PAWN, WHITE, 0, 0);
+	makeMove(&p, &e4, &fs);
+	outputPosition(&p);
+	genMoves(&ml, &p);
+	outputMoveList(&ml, '\n', FALSE);
+	Move e5 = createMove(E7_INT, E5_INT, FLAG_DOUBLE_PAWN_PUSH, B_PAWN, BLACK, 0, 0);
+	makeMove(&p, &e5, &fs);
+	outputPosition(&p);
+	genMoves(&ml, &p);
+	outputMoveList(&ml, '\n', FALSE);
+	Move nf3 = createMove(G1_INT, F3_INT, FLAG_QUIET_MOVE, W_KNIGHT, WHITE, 0, 0);
+	makeMove(&p, &nf3, &fs);
+	outputPosition(&p);
+	genMoves(&ml, &p);
+	outputMoveList(&ml, '\n', FALSE);
+	Move nf6 = createMove(G8_INT, F6_INT, FLAG_QUIET_MOVE, B_KNIGHT, BLACK, 0, 0);
+	makeMove(&p, &nf6, &fs);
+	outputPosition(&p);
+	genMoves(&ml, &p);
+	outputMoveList(&ml, '\n', FALSE);
+
+	freeMoveList(&ml);
+}
+
+void testPerft(int depth) {
+	Position p;
+	setupStartPosition(&p, &EVALUATOR);
+	IrrFlagStack fs;
+	initIrrFlagStack(&fs, 10);
+
+	if(PERF_ENABLED) {
+		startPerfCounters(&PERF_COUNTERS);
+	}
+	long nodes = perft(&p, &fs, depth);
+	if(PERF_ENABLED) {
+		stopPerfCounters(&PERF_COUNTERS);
+	}
+	printf("%ld\n", nodes);
+	if(PERF_ENABLED) {
+		outputPerfCounters(&PERF_COUNTERS, nodes);
+	}
+
+	freeIrrFlagStack(&fs);
+}
+
+void testAI(int depth) {
+	printf("test\n");
+	Position p;
+	setupStartPosition(&p, &EVALUATOR);
+	IrrFlagStack fs;
+	initIrrFlagStack(&fs, 10);
+
+	printf("%d\n", heuristicEval(&p));
+
+	freeIrrFlagStack(&fs);
+}
+
+int main(int argc, char** argv) {
+	initEvaluator(&EVALUATOR, EVAL_CACHE_DEFAULT_SIZE);
+
+	int defaultDepth = 4;
+	int defaultExtensions = 12;
+	int defaultBenchDepth = 3;
+	int defaultBenchExtensions = 2;
+
+	// Leading options, e.g. ./chess-b --evalcache 1048576 2 0
+	unsigned int evalCacheSize;
+	while(argc >= 2 && strncmp(argv[1], "--", 2) == 0) {
+		// Flags without a value
+		if(strcmp(argv[1], "--perf") == 0) {
+			PERF_ENABLED = openPerfCounters(&PERF_COUNTERS) > 0;
+			argc -= 1;
+			argv += 1;
+			continue;
+		}
+		if(strcmp(argv[1], "--nohugepages") == 0) {
+			HUGE_PAGES = FALSE;
+			argc -= 1;
+			argv += 1;
+			continue;
+		}
+		if(strcmp(argv[1], "--ponder") == 0) {
+			PONDER = TRUE;
+			argc -= 1;
+			argv += 1;
+			continue;
+		}
+		if(strcmp(argv[1], "--qchecks") == 0) {
+			QUIESCENCE_CHECKS = TRUE;
+			argc -= 1;
+			argv += 1;
+			continue;
+		}
+		if(argc < 3) {
+			printf("Missing value for %s\n", argv[1]);
+			return -1;
+		}
+		if(strcmp(argv[1], "--evalcache") == 0) {
+			sscanf(argv[2], "%u", &evalCacheSize);
+			freeEvalCache(&EVALUATOR.evalCache);
+			initEvalCache(&EVALUATOR.evalCache, evalCacheSize);
+			EVAL_CACHE_SIZE = evalCacheSize;
+		} else if(strcmp(argv[1], "--nnue") == 0) {
+			if(!loadEvaluatorNetwork(&EVALUATOR, argv[2])) {
+				return -1;
+			}
+			NNUE_PATH = argv[2];
+		} else if(strcmp(argv[1], "--hashfile") == 0) {
+			HASH_FILE = argv[2];
+		} else {
+			printf("Unknown option: %s\n", argv[1]);
+			return -1;
+		}
+		argc -= 2;
+		argv += 2;
+	}
+
+	if(argc >= 2 && strcmp(argv[1], "bench") == 0) {
+		int depth = defaultBenchDepth;
+		int extensions = defaultBenchExtensions;
+		if(argc >= 3) {
+			sscanf(argv[2], "%d", &depth);
+		}
+		if(argc >= 4) {
+			sscanf(argv[3], "%d", &extensions);
+		}
+		bench(depth, extensions, QUIESCENCE_CHECKS, HUGE_PAGES, &EVALUATOR, PERF_ENABLED ? &PERF_COUNTERS : NULL);
+	} else if(argc == 2 && strcmp(argv[1], "uci") == 0) {
+		uciLoop(&EVALUATOR, QUIESCENCE_CHECKS, HUGE_PAGES, HASH_FILE);
+	} else if(argc == 3 && strcmp(argv[1], "gennet") == 0) {
+		// Random weights test network for --nnue
+		return writeRandomNnueNetwork(argv[2], 0x9E3779B97F4A7C15ULL) ? 0 : -1;
+	} else if(argc == 2) {
+		int depth;
+		char* input1 = argv[1];
+		sscanf(argv[1], "%d", &depth);
+		testPerft(depth);
+	} else if(argc == 3) {
+		int a1, a2;
+		char* input1 = argv[1];
+		char* input2 = argv[2];
+		sscanf(argv[1], "%d", &a1);
+		sscanf(argv[2], "%d", &a2);
+		if(a1 == HUMAN && a2 == HUMAN) {
+			printf("Two player mode\n");
+			playGame(HUMAN, HUMAN, 0, 0, 0, 0, TRUE);
+		} else if(a1 == HUMAN && a2 != HUMAN) {
+			if(a2 == NORMAL_AI) {
+				printf("Playing white vs. normal AI with default settings\n");
+				playGame(HUMAN, NORMAL_AI, 0, 0, defaultDepth, defaultExtensions, TRUE);
+			} else if(a2 == IDS) {
+				printf("Playing white vs. IDS with default settings\n");
+				playGame(HUMAN, IDS, 0, 0, defaultDepth, defaultExtensions, TRUE);
+			}
+		} else if(a1 != HUMAN && a2 == HUMAN) {
+			if(a1 == NORMAL_AI) {
+				printf("Playing black vs. normal AI with default settings\n");
+				playGame(NORMAL_AI, HUMAN, defaultDepth, defaultExtensions, 0, 0, TRUE);
+			} else if(a1 == IDS) {
+				printf("Playing black vs. IDS with default settings\n");
+				playGame(IDS, HUMAN, defaultDepth, defaultExtensions, 0, 0, TRUE);
+			}
+		} else if(a1 == NORMAL_AI && a2 == NORMAL_AI) {
+			printf("Watching normal AI play itself with default settings\n");
+			playGame(NORMAL_AI, NORMAL_AI, defaultDepth, defaultExtensions, defaultDepth, defaultExtensions, TRUE);
+		} else if(a1 == IDS && a2 == IDS) {
+			printf("Watching IDS play itself with default settings\n");
+			playGame(IDS, IDS, defaultDepth, defaultExtensions, defaultDepth, defaultExtensions, TRUE);
+		}
+	} else if(argc == 5) {
+		int a1, a2, a3, a4;
+		char* input1 = argv[1];
+		char* input2 = argv[2];
+		char* input3 = argv[3];
+		char* input4 = argv[4];
+		sscanf(argv[1], "%d", &a1);
+		sscanf(argv[2], "%d", &a2);
+		sscanf(argv[3], "%d", &a3);
+		sscanf(argv[4], "%d", &a4);
+		if(a1 == HUMAN && a2 == IDS) {
+			printf("Playing white vs. IDS with depth=%d ext=%d\n", a3, a4);
+			playGame(HUMAN, IDS, 0, 0, a3, a4, TRUE);
+		} else if(a1 == IDS && a2 == IDS) {
+			printf("Watching IDS play itself with depth=%d ext=%d\n", a3, a4);
+			playGame(IDS, IDS, a3, a4, a3, a4, TRUE);
+		}
+	}
+	// 	char* input1 = argv[1];
+	// 	char* input2 = argv[2];
+	// 	int mode, depth, extensions;
+	// 	sscanf(argv[1], "%d", &mode);
+	// 	sscanf(argv[2], "%d", &depth);
+	// 	sscanf(argv[3], "%d", &extensions);
+	// 	if(mode < 0 || mode > 10 || depth < 0) {
+	// 		return -1;
+	// 	}
+	// 	switch(mode) {
+	// 		case 0:
+	// 			testPerft(depth); break;
+	// 		case 1:
+	// 			printf("Selected dirtyAI, WHITE\n");
+	// 			playGame(WHITE, depth, DIRTY_AI, extensions, TRUE); break;
+	// 		case 2:
+	// 			printf("Selected dirtyAI, BLACK\n");
+	// 			playGame(BLACK, depth, DIRTY_AI, extensions, TRUE); break;
+	// 		case 3:
+	// 			printf("Selected normalAI, WHITE\n");
+	// 			playGame(WHITE, depth, NORMAL_AI, extensions, TRUE); break;
+	// 		case 4:
+	// 			printf("Selected normalAI, BLACK\n");
+	// 			playGame(BLACK, depth, NORMAL_AI, extensions, TRUE); break;
+	// 		case 5:
+	// 			printf("Selected 2 player game\n");
+	// 			playGame(WHITE, depth, HUMAN, extensions, TRUE); break;
+	// 		case 6:
+	// 			testAI(depth);
+	// 		case 7:
+	// 			testPosition();
+	//
+	// 	}
+	// }
+	// testPosition();
+	// testMove();
+	// testMoveGen();
+	// testPerft(5);
+	// playGame(WHITE, 0, 0, 0);
+	if(PERF_ENABLED) {
+		closePerfCounters(&PERF_COUNTERS);
+	}
+	freeEvaluator(&EVALUATOR);
+	return 0;
+}
@@ -0,0 +1,283 @@
+// Microbenchmarks for the engine's primitives. Build with make, then
+//   ./microbench [NAME] [REPETITIONS]
+// to run every benchmark (or those whose name contains NAME). Each one is
+// run a few times to warm up, then timed over REPETITIONS passes of a fixed
+// position set, and reported in ns per operation.
+#include "chess-b.h"
+#include <math.h>
+
+#define MICROBENCH_WARMUP 3
+#define MICROBENCH_DEFAULT_REPS 15
+// Random moves played from each bench position, keeping every position seen
+#define MICROBENCH_PLIES 20
+#define MICROBENCH_MAX_POSITIONS 2048
+#define MICROBENCH_TT_KEYS (1<<20)
+
+typedef struct {
+	const char* name;
+	uint64_t (*run)(void); // One pass, returns number of operations
+} Microbench;
+
+Position BENCH_POSITIONS[MICROBENCH_MAX_POSITIONS];
+MoveList BENCH_LEGAL_MOVES[MICROBENCH_MAX_POSITIONS];
+int BENCH_POSITION_COUNT = 0;
+Evaluator BENCH_EVALUATOR;
+unsigned int* BENCH_TT_KEYS;
+HashTable BENCH_HASH_TABLE;
+IrrFlagStack BENCH_FLAG_STACK;
+// Results are summed into this, so the compiler can't drop the work
+volatile uint64_t BENCH_SINK;
+
+void initMicrobenchPositions() {
+	int i, ply;
+	uint64_t seed = 0x853C49E6748FEA9BULL;
+	Position p;
+	MoveList ml;
+	Move m;
+
+	for(i=0; i<BENCH_FEN_COUNT; i++) {
+		if(!setupPositionFromFen(&p, BENCH_FENS[i], &BENCH_EVALUATOR)) {
+			continue;
+		}
+		for(ply=0; ply<=MICROBENCH_PLIES && BENCH_POSITION_COUNT<MICROBENCH_MAX_POSITIONS; ply++) {
+			genLegalMoves(&ml, &p, &BENCH_FLAG_STACK);
+			if(ml.used == 0) {
+				freeMoveList(&ml);
+				break;
+			}
+			BENCH_POSITIONS[BENCH_POSITION_COUNT] = p;
+			BENCH_LEGAL_MOVES[BENCH_POSITION_COUNT++] = ml;
+			m = ml.list[xorshift64(&seed) % ml.used];
+			makeMove(&p, &m, &BENCH_FLAG_STACK);
+		}
+	}
+
+	BENCH_TT_KEYS = malloc(MICROBENCH_TT_KEYS * sizeof(unsigned int));
+	if(BENCH_TT_KEYS == NULL) {
+		printf("ERROR: MALLOC FAILED\n"); return;
+	}
+	for(i=0; i<MICROBENCH_TT_KEYS; i++) {
+		BENCH_TT_KEYS[i] = (unsigned int) xorshift64(&seed);
+	}
+}
+
+uint64_t benchGenMoves() {
+	MoveList ml;
+	uint64_t ops = 0;
+	int i;
+	for(i=0; i<BENCH_POSITION_COUNT; i++) {
+		genMoves(&ml, &BENCH_POSITIONS[i]);
+		BENCH_SINK += ml.used;
+		freeMoveList(&ml);
+		ops++;
+	}
+	return ops;
+}
+
+uint64_t benchGenLegalMoves() {
+	MoveList ml;
+	uint64_t ops = 0;
+	int i;
+	for(i=0; i<BENCH_POSITION_COUNT; i++) {
+		genLegalMoves(&ml, &BENCH_POSITIONS[i], &BENCH_FLAG_STACK);
+		BENCH_SINK += ml.used;
+		freeMoveList(&ml);
+		ops++;
+	}
+	return ops;
+}
+
+// Only the positions where the side to move is in check
+uint64_t benchGenLegalEvasions() {
+	MoveList ml;
+	uint64_t ops = 0;
+	int i;
+	for(i=0; i<BENCH_POSITION_COUNT; i++) {
+		if(!getCheckers(&BENCH_POSITIONS[i])) {
+			continue;
+		}
+		genLegalMoves(&ml, &BENCH_POSITIONS[i], &BENCH_FLAG_STACK);
+		BENCH_SINK += ml.used;
+		freeMoveList(&ml);
+		ops++;
+	}
+	return ops;
+}
+
+uint64_t benchGenCaptures() {
+	MoveList ml;
+	uint64_t ops = 0;
+	int i;
+	for(i=0; i<BENCH_POSITION_COUNT; i++) {
+		initMoveList(&ml, 8);
+		if(BENCH_POSITIONS[i].player == WHITE) {
+			genWhiteCaptures(&ml, &BENCH_POSITIONS[i]);
+		} else {
+			genBlackCaptures(&ml, &BENCH_POSITIONS[i]);
+		}
+		BENCH_SINK += ml.used;
+		freeMoveList(&ml);
+		ops++;
+	}
+	return ops;
+}
+
+uint64_t benchGenLegalCaptures() {
+	MoveList ml;
+	uint64_t ops = 0;
+	int i;
+	for(i=0; i<BENCH_POSITION_COUNT; i++) {
+		genCaptures(&ml, &BENCH_POSITIONS[i], &BENCH_FLAG_STACK);
+		BENCH_SINK += ml.used;
+		freeMoveList(&ml);
+		ops++;
+	}
+	return ops;
+}
+
+// One op is a makeMove/unmakeMove pair
+uint64_t benchMakeUnmake() {
+	uint64_t ops = 0;
+	int i, j;
+	Position* p;
+	for(i=0; i<BENCH_POSITION_COUNT; i++) {
+		p = &BENCH_POSITIONS[i];
+		for(j=0; j<BENCH_LEGAL_MOVES[i].used; j++) {
+			makeMove(p, &BENCH_LEGAL_MOVES[i].list[j], &BENCH_FLAG_STACK);
+			BENCH_SINK += p->hash;
+			unmakeMove(p, &BENCH_LEGAL_MOVES[i].list[j], &BENCH_FLAG_STACK);
+			ops++;
+		}
+	}
+	return ops;
+}
+
+// Every square, by both sides
+uint64_t benchAttackedBy() {
+	uint64_t ops = 0;
+	int i, square;
+	for(i=0; i<BENCH_POSITION_COUNT; i++) {
+		for(square=0; square<64; square++) {
+			BENCH_SINK += attackedByWhite(&BENCH_POSITIONS[i], SQUARE_BBS[square]);
+			BENCH_SINK += attackedByBlack(&BENCH_POSITIONS[i], SQUARE_BBS[square]);
+			ops += 2;
+		}
+	}
+	return ops;
+}
+
+uint64_t benchHeuristicEval() {
+	uint64_t ops = 0;
+	int i;
+	for(i=0; i<BENCH_POSITION_COUNT; i++) {
+		BENCH_SINK += heuristicEval(&BENCH_POSITIONS[i]);
+		ops++;
+	}
+	return ops;
+}
+
+uint64_t benchTTStore() {
+	Move m = BENCH_LEGAL_MOVES[0].list[0];
+	uint64_t ops = 0;
+	int i;
+	for(i=0; i<MICROBENCH_TT_KEYS; i++) {
+		addToHashTable(&BENCH_HASH_TABLE, BENCH_TT_KEYS[i], m, i & 15, i, PV_NODE);
+		ops++;
+	}
+	return ops;
+}
+
+uint64_t benchTTProbe() {
+	HashTableEntry* entry;
+	uint64_t ops = 0;
+	int i;
+	for(i=0; i<MICROBENCH_TT_KEYS; i++) {
+		entry = getFromHashTable(&BENCH_HASH_TABLE, BENCH_TT_KEYS[i]);
+		BENCH_SINK += (entry->key == BENCH_TT_KEYS[i]) ? entry->score : 0;
+		ops++;
+	}
+	return ops;
+}
+
+Microbench MICROBENCHES[] = {
+	{"genMoves", benchGenMoves},
+	{"genLegalMoves", benchGenLegalMoves},
+	{"genLegalMoves (in check)", benchGenLegalEvasions},
+	{"genCaptures (pseudo-legal)", benchGenCaptures},
+	{"genCaptures", benchGenLegalCaptures},
+	{"makeMove+unmakeMove", benchMakeUnmake},
+	{"attackedByWhite/Black", benchAttackedBy},
+	{"heuristicEval", benchHeuristicEval},
+	{"TT store", benchTTStore},
+	{"TT probe", benchTTProbe}
+};
+
+uint64_t nowNs() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+int compareDoubles(const void* a, const void* b) {
+	double x = *(const double*) a;
+	double y = *(const double*) b;
+	return (x > y) - (x < y);
+}
+
+void runMicrobench(Microbench* mb, int reps) {
+	double nsPerOp[reps];
+	double mean = 0, variance = 0;
+	uint64_t start, ops;
+	int i;
+
+	for(i=0; i<MICROBENCH_WARMUP; i++) {
+		mb->run();
+	}
+	for(i=0; i<reps; i++) {
+		start = nowNs();
+		ops = mb->run();
+		nsPerOp[i] = (double)(nowNs() - start) / (ops > 0 ? ops : 1);
+		mean += nsPerOp[i];
+	}
+	mean /= reps;
+	for(i=0; i<reps; i++) {
+		variance += (nsPerOp[i] - mean) * (nsPerOp[i] - mean);
+	}
+	variance /= reps;
+	qsort(nsPerOp, reps, sizeof(double), compareDoubles);
+
+	printf("%-28s %10" PRIu64 " %10.1f %10.1f %10.1f %9.1f%%\n", mb->name, ops,
+		nsPerOp[0], nsPerOp[reps / 2], mean, (mean > 0) ? 100 * sqrt(variance) / mean : 0.0);
+}
+
+int main(int argc, char** argv) {
+	const char* filter = (argc >= 2) ? argv[1] : "";
+	int reps = MICROBENCH_DEFAULT_REPS;
+	int i, numBenches = sizeof(MICROBENCHES) / sizeof(MICROBENCHES[0]);
+	if(argc >= 3) {
+		sscanf(argv[2], "%d", &reps);
+	}
+	reps = (reps > 0) ? reps : 1;
+
+	initEvaluator(&BENCH_EVALUATOR, EVAL_CACHE_DEFAULT_SIZE);
+	initIrrFlagStack(&BENCH_FLAG_STACK, 64);
+	initHashTable(&BENCH_HASH_TABLE, TRUE);
+	initMicrobenchPositions();
+
+	printf("%d positions, %d repetitions after %d warmup\n", BENCH_POSITION_COUNT, reps, MICROBENCH_WARMUP);
+	printf("%-28s %10s %10s %10s %10s %10s\n", "benchmark", "ops/rep", "min ns/op", "median", "mean", "stddev");
+	for(i=0; i<numBenches; i++) {
+		if(strstr(MICROBENCHES[i].name, filter) != NULL) {
+			runMicrobench(&MICROBENCHES[i], reps);
+		}
+	}
+
+	for(i=0; i<BENCH_POSITION_COUNT; i++) {
+		freeMoveList(&BENCH_LEGAL_MOVES[i]);
+	}
+	free(BENCH_TT_KEYS);
+	freeHashTable(&BENCH_HASH_TABLE);
+	freeIrrFlagStack(&BENCH_FLAG_STACK);
+	freeEvaluator(&BENCH_EVALUATOR);
+	return 0;
+}
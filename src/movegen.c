@@ -0,0 +1,679 @@
+// Pseudo-legal and legal move generation, attack detection and perft
+#include "chess-b.h"
+
+void initMoveList(MoveList* ml, int initSize) {
+	ml->list = malloc(initSize * sizeof(Move));
+	if(ml->list == NULL) {
+		printf("ERROR: MALLOC FAILED\n"); return;
+	}
+	ml->used = 0;
+	ml->size = initSize;
+}
+
+// Add another Move to ml, expanding as needed
+void insertMoveList(MoveList* ml, Move m) {
+	if(ml->used == ml->size) {
+		ml->size *= 2;
+		ml->list = realloc(ml->list, ml->size * sizeof(Move));
+		if(ml->list == NULL) {
+			printf("ERROR: REALLOC FAILED\n"); return;
+		}
+	}
+	ml->list[ml->used++] = m;
+}
+
+// Add another Move to ml, expanding as needed
+void insertMoveListReference(MoveList* ml, Move* m) {
+	if(ml->used == ml->size) {
+		ml->size *= 2;
+		ml->list = realloc(ml->list, ml->size * sizeof(Move));
+		if(ml->list == NULL) {
+			printf("ERROR: REALLOC FAILED\n"); return;
+		}
+	}
+	ml->list[ml->used++] = *m;
+}
+
+Move* popMoveList(MoveList* ml) {
+	if(ml->used == 0) {
+		printf("ERROR: EMPTY STACK"); return NULL;
+	}
+	return &(ml->list[--(ml->used)]);
+}
+
+void pushMoveList(MoveList* ml, int from, int to, int flags, int piece, int colour, int cPiece, int cColour) {
+	Move m;
+	m.from = from;
+	m.to = to;
+	m.flags = flags;
+	m.piece = piece;
+	m.colour = colour;
+	m.cPiece = cPiece;
+	m.cColour = cColour;
+	if(ml->used == ml->size) {
+		ml->size *= 2;
+		ml->list = realloc(ml->list, ml->size * sizeof(Move));
+		if(ml->list == NULL) {
+			printf("ERROR: REALLOC FAILED\n"); return;
+		}
+	}
+	ml->list[ml->used++] = m;
+}
+
+// Reset ml, freeing memory
+void freeMoveList(MoveList* ml) {
+	free(ml->list);
+	ml->list = NULL;
+	ml->used = ml->size = 0;
+}
+
+// The generators below are written once, on the side to move. Each is always
+// inlined into a wrapper that passes WHITE or BLACK as a constant, so the
+// colour arithmetic folds away and each colour gets its own specialised copy
+#define GEN_INLINE static inline __attribute__((always_inline))
+
+// The 'allowed' mask of the piece and pawn generators, when every
+// destination is. Check evasions restrict it to the checker and the squares
+// between it and the king
+#define ALL_SQUARES (~(uint64_t) 0)
+
+GEN_INLINE int attackedByEnemy(Position* p, uint64_t bb, int colour) {
+	return (colour == WHITE) ? attackedByBlack(p, bb) : attackedByWhite(p, bb);
+}
+
+// Push a move from 'from' to every enemy piece in targets, most valuable
+// victim first and each victim's squares in ascending order
+GEN_INLINE void pushCaptures(MoveList* ml, Position* p, int from, uint64_t targets, int piece, int colour) {
+	int victim;
+	uint64_t victims;
+	for(victim=W_QUEEN; victim>=W_PAWN; victim--) {
+		for(victims = targets & p->pieceBB[victim + 6*!colour]; victims; victims &= victims - 1) {
+			pushMoveList(ml, from, bitScanForward(victims), FLAG_CAPTURES, piece, colour, victim + 6*!colour, !colour);
+		}
+	}
+}
+
+GEN_INLINE void pushQuiets(MoveList* ml, int from, uint64_t targets, int piece, int colour) {
+	for(; targets; targets &= targets - 1) {
+		pushMoveList(ml, from, bitScanForward(targets), FLAG_QUIET_MOVE, piece, colour, 0, 0);
+	}
+}
+
+// Knights, bishops, rooks and queens. type is the white piece. Only moves to
+// squares in allowed are generated
+GEN_INLINE void genPieceMoves(MoveList* ml, Position* p, int type, int colour, int quiets, uint64_t allowed) {
+	int from, piece = type + 6*colour;
+	uint64_t pieces, targets;
+	for(pieces = p->pieceBB[piece]; pieces; pieces &= pieces - 1) {
+		from = bitScanForward(pieces);
+		switch(type) {
+			case W_KNIGHT:	targets = KNIGHT_ATTACKS[from]; break;
+			case W_BISHOP:	targets = bishopAttacks(p, from); break;
+			case W_ROOK:		targets = rookAttacks(p, from); break;
+			default:				targets = queenAttacks(p, from); break;
+		}
+		targets &= allowed;
+		pushCaptures(ml, p, from, targets & p->pieceBB[!colour], piece, colour);
+		if(quiets) {
+			pushQuiets(ml, from, targets & p->emptyBB, piece, colour);
+		}
+	}
+}
+
+GEN_INLINE void genKingMoves(MoveList* ml, Position* p, int colour, int quiets) {
+	int king = W_KING + 6*colour;
+	int from = LOG2(p->pieceBB[king]);
+	// Castling squares are on the back rank, E1_INT etc. offset by this
+	int backRank = (colour == WHITE) ? 0 : 56;
+	uint64_t bb, dangerSquares = 0;
+	uint64_t targets = KING_ATTACKS[from];
+
+	// Neighbouring squares attacked by the enemy, with the king temporarily
+	// vanished so it doesn't block a slider's attack on the square behind it
+	p->occupiedBB	^= p->pieceBB[king];
+	p->emptyBB		^= p->pieceBB[king];
+	for(bb = targets; bb; bb &= bb - 1) {
+		if(attackedByEnemy(p, bb & -bb, colour)) {
+			dangerSquares |= bb & -bb;
+		}
+	}
+	p->occupiedBB	^= p->pieceBB[king];
+	p->emptyBB		^= p->pieceBB[king];
+	targets &= ~dangerSquares;
+
+	pushCaptures(ml, p, from, targets & p->pieceBB[!colour], king, colour);
+	if(!quiets) {
+		return;
+	}
+	pushQuiets(ml, from, targets & p->emptyBB, king, colour);
+
+	if((p->flag.castlingFlags & ((colour == WHITE) ? W_KSIDE_CASTLE : B_KSIDE_CASTLE))
+		&& (p->emptyBB & SQUARE_BBS[F1_INT + backRank]) && (p->emptyBB & SQUARE_BBS[G1_INT + backRank])
+		&& !attackedByEnemy(p, SQUARE_BBS[E1_INT + backRank], colour) && !attackedByEnemy(p, SQUARE_BBS[F1_INT + backRank], colour)
+		&& !attackedByEnemy(p, SQUARE_BBS[G1_INT + backRank], colour)) {
+		pushMoveList(ml, E1_INT + backRank, G1_INT + backRank, FLAG_KING_CASTLE, king, colour, 0, 0);
+	}
+	if((p->flag.castlingFlags & ((colour == WHITE) ? W_QSIDE_CASTLE : B_QSIDE_CASTLE))
+		&& (p->emptyBB & SQUARE_BBS[D1_INT + backRank]) && (p->emptyBB & SQUARE_BBS[C1_INT + backRank])
+		&& (p->emptyBB & SQUARE_BBS[B1_INT + backRank])
+		&& !attackedByEnemy(p, SQUARE_BBS[E1_INT + backRank], colour) && !attackedByEnemy(p, SQUARE_BBS[D1_INT + backRank], colour)
+		&& !attackedByEnemy(p, SQUARE_BBS[C1_INT + backRank], colour)) {
+		pushMoveList(ml, E1_INT + backRank, C1_INT + backRank, FLAG_QUEEN_CASTLE, king, colour, 0, 0);
+	}
+}
+
+// Pawn targets are shifted by a constant from their pawns: << for white's
+// positive shifts, >> for black's negative ones
+GEN_INLINE uint64_t shiftBy(uint64_t bb, int shift) {
+	return (shift > 0) ? bb << shift : bb >> -shift;
+}
+
+// Push a move to each target from the square 'shift' behind it
+GEN_INLINE void pushPawnMoves(MoveList* ml, uint64_t targets, int shift, int flags, int colour) {
+	int to;
+	for(; targets; targets &= targets - 1) {
+		to = bitScanForward(targets);
+		pushMoveList(ml, to - shift, to, flags, W_PAWN + 6*colour, colour, 0, 0);
+	}
+}
+
+// As pushCaptures, for pawns capturing onto targets from 'shift' behind them
+GEN_INLINE void pushPawnCaptures(MoveList* ml, Position* p, uint64_t targets, int shift, int colour) {
+	int victim, to;
+	uint64_t victims;
+	for(victim=W_QUEEN; victim>=W_PAWN; victim--) {
+		for(victims = targets & p->pieceBB[victim + 6*!colour]; victims; victims &= victims - 1) {
+			to = bitScanForward(victims);
+			pushMoveList(ml, to - shift, to, FLAG_CAPTURES, W_PAWN + 6*colour, colour, victim + 6*!colour, !colour);
+		}
+	}
+}
+
+GEN_INLINE void pushPromotions(MoveList* ml, uint64_t targets, int shift, int colour) {
+	int to;
+	for(; targets; targets &= targets - 1) {
+		to = bitScanForward(targets);
+		pushMoveList(ml, to - shift, to, FLAG_QUEEN_PROMO, W_PAWN + 6*colour, colour, 0, 0);
+		pushMoveList(ml, to - shift, to, FLAG_ROOK_PROMO, W_PAWN + 6*colour, colour, 0, 0);
+		pushMoveList(ml, to - shift, to, FLAG_BISHOP_PROMO, W_PAWN + 6*colour, colour, 0, 0);
+		pushMoveList(ml, to - shift, to, FLAG_KNIGHT_PROMO, W_PAWN + 6*colour, colour, 0, 0);
+	}
+}
+
+GEN_INLINE void pushPromoCaptures(MoveList* ml, Position* p, uint64_t targets, int shift, int colour) {
+	int victim, to;
+	uint64_t victims;
+	for(victim=W_QUEEN; victim>=W_KNIGHT; victim--) {
+		for(victims = targets & p->pieceBB[victim + 6*!colour]; victims; victims &= victims - 1) {
+			to = bitScanForward(victims);
+			pushMoveList(ml, to - shift, to, FLAG_QUEEN_PROMO_CAPT, W_PAWN + 6*colour, colour, victim + 6*!colour, !colour);
+			pushMoveList(ml, to - shift, to, FLAG_ROOK_PROMO_CAPT, W_PAWN + 6*colour, colour, victim + 6*!colour, !colour);
+			pushMoveList(ml, to - shift, to, FLAG_BISHOP_PROMO_CAPT, W_PAWN + 6*colour, colour, victim + 6*!colour, !colour);
+			pushMoveList(ml, to - shift, to, FLAG_KNIGHT_PROMO_CAPT, W_PAWN + 6*colour, colour, victim + 6*!colour, !colour);
+		}
+	}
+}
+
+// Set-wise: each kind of pawn move is found for every pawn at once by shifting
+// the pawn bitboard, and only the resulting target sets are serialised. Moves
+// come out promotions first, then captures, en passant and pushes. quiets
+// FALSE leaves out pushes, except promotions which are always generated. Only
+// moves to squares in allowed are, except that en passant is also allowed if
+// the pawn it captures is
+GEN_INLINE void genPawnMoves(MoveList* ml, Position* p, int colour, int quiets, uint64_t allowed) {
+	// Shifts for a push, and for captures towards the mover's left and right
+	int up = (colour == WHITE) ? 8 : -8;
+	int left = (colour == WHITE) ? 7 : -7;
+	int right = (colour == WHITE) ? 9 : -9;
+	uint64_t leftFile = (colour == WHITE) ? A_FILE : H_FILE;
+	uint64_t rightFile = (colour == WHITE) ? H_FILE : A_FILE;
+	uint64_t promoRank = (colour == WHITE) ? RANK_8 : RANK_1;
+	uint64_t pawns = p->pieceBB[W_PAWN + 6*colour];
+	uint64_t enemies = p->pieceBB[!colour];
+	uint64_t pushes = shiftBy(pawns, up) & p->emptyBB;
+	uint64_t leftCaptures = shiftBy(pawns & ~leftFile, left) & enemies & allowed;
+	uint64_t rightCaptures = shiftBy(pawns & ~rightFile, right) & enemies & allowed;
+	uint64_t epSquare, epPawns, doublePushes;
+
+	// Double pushes go via a single push's square, which needn't be allowed
+	doublePushes = shiftBy(pushes & ((colour == WHITE) ? RANK_3 : RANK_6), up) & p->emptyBB & allowed;
+	pushes &= allowed;
+
+	pushPromotions(ml, pushes & promoRank, up, colour);
+	pushPromoCaptures(ml, p, leftCaptures & promoRank, left, colour);
+	pushPromoCaptures(ml, p, rightCaptures & promoRank, right, colour);
+	pushPawnCaptures(ml, p, leftCaptures & ~promoRank, left, colour);
+	pushPawnCaptures(ml, p, rightCaptures & ~promoRank, right, colour);
+
+	// enPassantFlag is the square of the enemy pawn that just double pushed.
+	// It's 0 when there isn't one, which this rank test rules out
+	epSquare = SQUARE_BBS[p->flag.enPassantFlag] & p->pieceBB[W_PAWN + 6*!colour] & ((colour == WHITE) ? RANK_5 : RANK_4);
+	if(epSquare && ((epSquare & allowed) || (shiftBy(epSquare, up) & allowed))) {
+		for(epPawns = pawns & (westOne(epSquare) | eastOne(epSquare)); epPawns; epPawns &= epPawns - 1) {
+			pushMoveList(ml, bitScanForward(epPawns), p->flag.enPassantFlag + up, FLAG_EP_CAPTURE, W_PAWN + 6*colour, colour, W_PAWN + 6*!colour, !colour);
+		}
+	}
+
+	if(quiets) {
+		pushPawnMoves(ml, pushes & ~promoRank, up, FLAG_PAWN_PUSH, colour);
+		pushPawnMoves(ml, doublePushes, 2*up, FLAG_DOUBLE_PAWN_PUSH, colour);
+	}
+}
+
+void genWhiteCaptures(MoveList* ml, Position* p) {
+	genPawnMoves(ml, p, WHITE, FALSE, ALL_SQUARES);
+	genPieceMoves(ml, p, W_KNIGHT, WHITE, FALSE, ALL_SQUARES);
+	genPieceMoves(ml, p, W_BISHOP, WHITE, FALSE, ALL_SQUARES);
+	genPieceMoves(ml, p, W_ROOK, WHITE, FALSE, ALL_SQUARES);
+	genPieceMoves(ml, p, W_QUEEN, WHITE, FALSE, ALL_SQUARES);
+	genKingMoves(ml, p, WHITE, FALSE);
+}
+
+void genBlackCaptures(MoveList* ml, Position* p) {
+	genPawnMoves(ml, p, BLACK, FALSE, ALL_SQUARES);
+	genPieceMoves(ml, p, W_KNIGHT, BLACK, FALSE, ALL_SQUARES);
+	genPieceMoves(ml, p, W_BISHOP, BLACK, FALSE, ALL_SQUARES);
+	genPieceMoves(ml, p, W_ROOK, BLACK, FALSE, ALL_SQUARES);
+	genPieceMoves(ml, p, W_QUEEN, BLACK, FALSE, ALL_SQUARES);
+	genKingMoves(ml, p, BLACK, FALSE);
+}
+
+void genWhiteMoves(MoveList* ml, Position* p) {
+	genPawnMoves(ml, p, WHITE, TRUE, ALL_SQUARES);
+	genPieceMoves(ml, p, W_BISHOP, WHITE, TRUE, ALL_SQUARES);
+	genPieceMoves(ml, p, W_ROOK, WHITE, TRUE, ALL_SQUARES);
+	genPieceMoves(ml, p, W_KNIGHT, WHITE, TRUE, ALL_SQUARES);
+	genPieceMoves(ml, p, W_QUEEN, WHITE, TRUE, ALL_SQUARES);
+	genKingMoves(ml, p, WHITE, TRUE);
+}
+
+void genBlackMoves(MoveList* ml, Position* p) {
+	genPawnMoves(ml, p, BLACK, TRUE, ALL_SQUARES);
+	genPieceMoves(ml, p, W_BISHOP, BLACK, TRUE, ALL_SQUARES);
+	genPieceMoves(ml, p, W_ROOK, BLACK, TRUE, ALL_SQUARES);
+	genPieceMoves(ml, p, W_KNIGHT, BLACK, TRUE, ALL_SQUARES);
+	genPieceMoves(ml, p, W_QUEEN, BLACK, TRUE, ALL_SQUARES);
+	genKingMoves(ml, p, BLACK, TRUE);
+}
+
+// In check, only king moves and, against a single checker, captures of it and
+// interpositions can be legal. Those are all that's generated, still
+// pseudo-legal as a pinned piece may capture or block
+GEN_INLINE void genEvasionMoves(MoveList* ml, Position* p, int colour, uint64_t checkers) {
+	int king = LOG2(p->pieceBB[W_KING + 6*colour]);
+	uint64_t allowed;
+
+	genKingMoves(ml, p, colour, TRUE);
+	// Double check, only the king can move
+	if(checkers & (checkers - 1)) {
+		return;
+	}
+	allowed = checkers | BETWEEN_BBS[king][bitScanForward(checkers)];
+	genPawnMoves(ml, p, colour, TRUE, allowed);
+	genPieceMoves(ml, p, W_BISHOP, colour, TRUE, allowed);
+	genPieceMoves(ml, p, W_ROOK, colour, TRUE, allowed);
+	genPieceMoves(ml, p, W_KNIGHT, colour, TRUE, allowed);
+	genPieceMoves(ml, p, W_QUEEN, colour, TRUE, allowed);
+}
+
+// Quiet moves of the piece on from, which is a discoverer: moving it anywhere
+// off line, the squares between the enemy king and our slider behind it,
+// gives check
+GEN_INLINE void genDiscoveredChecks(MoveList* ml, Position* p, int colour, int from, uint64_t line) {
+	int type, up = (colour == WHITE) ? 8 : -8;
+	uint64_t bb, targets = 0, fromBB = SQUARE_BBS[from];
+
+	for(type=W_PAWN; type<=W_KING; type++) {
+		if(p->pieceBB[type + 6*colour] & fromBB) {
+			break;
+		}
+	}
+	switch(type) {
+		case W_PAWN:
+			// Promotions are generated with the captures
+			bb = shiftBy(fromBB, up) & p->emptyBB & ~(RANK_1 | RANK_8);
+			if(bb & ~line) {
+				pushMoveList(ml, from, from + up, FLAG_PAWN_PUSH, W_PAWN + 6*colour, colour, 0, 0);
+			}
+			bb = shiftBy(bb & ((colour == WHITE) ? RANK_3 : RANK_6), up) & p->emptyBB;
+			if(bb & ~line) {
+				pushMoveList(ml, from, from + 2*up, FLAG_DOUBLE_PAWN_PUSH, W_PAWN + 6*colour, colour, 0, 0);
+			}
+			return;
+		case W_KNIGHT:	targets = KNIGHT_ATTACKS[from]; break;
+		case W_BISHOP:	targets = bishopAttacks(p, from); break;
+		case W_ROOK:		targets = rookAttacks(p, from); break;
+		case W_QUEEN:		targets = queenAttacks(p, from); break;
+		case W_KING:
+			// Only to squares the enemy doesn't attack, as the legality filter
+			// takes king moves as safe
+			p->occupiedBB	^= fromBB;
+			p->emptyBB		^= fromBB;
+			for(bb = KING_ATTACKS[from] & p->emptyBB & ~line; bb; bb &= bb - 1) {
+				if(!attackedByEnemy(p, bb & -bb, colour)) {
+					targets |= bb & -bb;
+				}
+			}
+			p->occupiedBB	^= fromBB;
+			p->emptyBB		^= fromBB;
+			break;
+	}
+	pushQuiets(ml, from, targets & p->emptyBB & ~line, type + 6*colour, colour);
+}
+
+// Quiet moves that give check, directly or by discovery. A piece checks
+// directly by moving to one of its type's check squares, those it would
+// attack the enemy king from. Castling into check isn't generated
+GEN_INLINE void genQuietCheckMoves(MoveList* ml, Position* p, int colour) {
+	int from, sniper, king = LOG2(p->pieceBB[W_KING + 6*!colour]);
+	int up = (colour == WHITE) ? 8 : -8;
+	uint64_t diagonals = p->pieceBB[W_BISHOP + 6*colour] | p->pieceBB[W_QUEEN + 6*colour];
+	uint64_t straights = p->pieceBB[W_ROOK + 6*colour] | p->pieceBB[W_QUEEN + 6*colour];
+	uint64_t pawnChecks = (colour == WHITE) ? blackPawnAttacks(king) : whitePawnAttacks(king);
+	uint64_t knightChecks = KNIGHT_ATTACKS[king];
+	uint64_t bishopChecks = bishopAttacks(p, king);
+	uint64_t rookChecks = rookAttacks(p, king);
+	uint64_t snipers, blockers, pieces, pushes, discoverers = 0;
+
+	// Our sliders on a line with the enemy king, with just one of our own
+	// pieces in between
+	snipers = (diagonals & (RAY_ATTACK_ARRAYS[DIR_NW][king] | RAY_ATTACK_ARRAYS[DIR_NE][king]
+		| RAY_ATTACK_ARRAYS[DIR_SE][king] | RAY_ATTACK_ARRAYS[DIR_SW][king]))
+		| (straights & (RAY_ATTACK_ARRAYS[DIR_N][king] | RAY_ATTACK_ARRAYS[DIR_E][king]
+		| RAY_ATTACK_ARRAYS[DIR_S][king] | RAY_ATTACK_ARRAYS[DIR_W][king]));
+	for(; snipers; snipers &= snipers - 1) {
+		sniper = bitScanForward(snipers);
+		blockers = BETWEEN_BBS[king][sniper] & p->occupiedBB;
+		if(blockers && !(blockers & (blockers - 1)) && (blockers & p->pieceBB[colour])) {
+			discoverers |= blockers;
+			genDiscoveredChecks(ml, p, colour, bitScanForward(blockers), BETWEEN_BBS[king][sniper]);
+		}
+	}
+
+	// Direct checks, from pieces that didn't give a discovered one
+	pieces = p->pieceBB[W_PAWN + 6*colour] & ~discoverers;
+	pushes = shiftBy(pieces, up) & p->emptyBB & ~(RANK_1 | RANK_8);
+	pushPawnMoves(ml, pushes & pawnChecks, up, FLAG_PAWN_PUSH, colour);
+	pushes = shiftBy(pushes & ((colour == WHITE) ? RANK_3 : RANK_6), up) & p->emptyBB;
+	pushPawnMoves(ml, pushes & pawnChecks, 2*up, FLAG_DOUBLE_PAWN_PUSH, colour);
+	for(pieces = p->pieceBB[W_KNIGHT + 6*colour] & ~discoverers; pieces; pieces &= pieces - 1) {
+		from = bitScanForward(pieces);
+		pushQuiets(ml, from, KNIGHT_ATTACKS[from] & p->emptyBB & knightChecks, W_KNIGHT + 6*colour, colour);
+	}
+	for(pieces = p->pieceBB[W_BISHOP + 6*colour] & ~discoverers; pieces; pieces &= pieces - 1) {
+		from = bitScanForward(pieces);
+		pushQuiets(ml, from, bishopAttacks(p, from) & p->emptyBB & bishopChecks, W_BISHOP + 6*colour, colour);
+	}
+	for(pieces = p->pieceBB[W_ROOK + 6*colour] & ~discoverers; pieces; pieces &= pieces - 1) {
+		from = bitScanForward(pieces);
+		pushQuiets(ml, from, rookAttacks(p, from) & p->emptyBB & rookChecks, W_ROOK + 6*colour, colour);
+	}
+	for(pieces = p->pieceBB[W_QUEEN + 6*colour] & ~discoverers; pieces; pieces &= pieces - 1) {
+		from = bitScanForward(pieces);
+		pushQuiets(ml, from, queenAttacks(p, from) & p->emptyBB & (bishopChecks | rookChecks), W_QUEEN + 6*colour, colour);
+	}
+}
+
+// checkers is getCheckers(p), which must be non-zero
+void genEvasions(MoveList* ml, Position* p, uint64_t checkers) {
+	initMoveList(ml, 16);
+	if(p->player == WHITE) {
+		genEvasionMoves(ml, p, WHITE, checkers);
+	} else {
+		genEvasionMoves(ml, p, BLACK, checkers);
+	}
+}
+
+void genMoves(MoveList* ml, Position* p) {
+	// ml->used = 0;
+	initMoveList(ml, 30);
+	if(p->player == WHITE) {
+		genWhiteMoves(ml, p);
+	} else {
+		genBlackMoves(ml, p);
+	}
+}
+
+uint64_t attackedByBlackBitBoard(Position* p, uint64_t bb) {
+	// int square = bitScanReverse(bb);
+	int square = LOG2(bb);
+
+ 	uint64_t attacks = whitePawnAttacks(square);
+	uint64_t validAttacks = attacks & p->pieceBB[B_PAWN];
+	attacks = KNIGHT_ATTACKS[square];
+	validAttacks |= (attacks & p->pieceBB[B_KNIGHT]);
+	attacks = bishopAttacks(p, square);
+	validAttacks |= (attacks & p->pieceBB[B_BISHOP]);
+	attacks = rookAttacks(p, square);
+	validAttacks |= (attacks & p->pieceBB[B_ROOK]);
+	attacks = queenAttacks(p, square);
+	validAttacks |= (attacks & p->pieceBB[B_QUEEN]);
+	attacks = KING_ATTACKS[square];
+	validAttacks |= (attacks & p->pieceBB[B_KING]);
+	return (validAttacks > 0) ? bb : 0;
+}
+
+int attackedByBlack(Position* p, uint64_t bb) {
+	// int square = bitScanReverse(bb);
+	int square = LOG2(bb);
+
+ 	uint64_t attacks = whitePawnAttacks(square);
+	uint64_t validAttacks = attacks & p->pieceBB[B_PAWN];
+	attacks = KNIGHT_ATTACKS[square];
+	validAttacks |= (attacks & p->pieceBB[B_KNIGHT]);
+	attacks = bishopAttacks(p, square);
+	validAttacks |= (attacks & p->pieceBB[B_BISHOP]);
+	attacks = rookAttacks(p, square);
+	validAttacks |= (attacks & p->pieceBB[B_ROOK]);
+	attacks = queenAttacks(p, square);
+	validAttacks |= (attacks & p->pieceBB[B_QUEEN]);
+	attacks = KING_ATTACKS[square];
+	validAttacks |= (attacks & p->pieceBB[B_KING]);
+	return (validAttacks > 0);
+}
+
+uint64_t attackedByWhiteBitBoard(Position* p, uint64_t bb) {
+	// int square = bitScanReverse(bb);
+	int square = LOG2(bb);
+
+ 	uint64_t attacks = blackPawnAttacks(square);
+	uint64_t validAttacks = attacks & p->pieceBB[W_PAWN];
+	attacks = KNIGHT_ATTACKS[square];
+	validAttacks |= (attacks & p->pieceBB[W_KNIGHT]);
+	attacks = bishopAttacks(p, square);
+	validAttacks |= (attacks & p->pieceBB[W_BISHOP]);
+	attacks = rookAttacks(p, square);
+	validAttacks |= (attacks & p->pieceBB[W_ROOK]);
+	attacks = queenAttacks(p, square);
+	validAttacks |= (attacks & p->pieceBB[W_QUEEN]);
+	attacks = KING_ATTACKS[square];
+	validAttacks |= (attacks & p->pieceBB[W_KING]);
+	return (validAttacks > 0) ? bb : 0;
+}
+
+int attackedByWhite(Position* p, uint64_t bb) {
+	// int square = bitScanReverse(bb);
+	int square = LOG2(bb);
+
+ 	uint64_t attacks = blackPawnAttacks(square);
+	uint64_t validAttacks = attacks & p->pieceBB[W_PAWN];
+	attacks = KNIGHT_ATTACKS[square];
+	validAttacks |= (attacks & p->pieceBB[W_KNIGHT]);
+	attacks = bishopAttacks(p, square);
+	validAttacks |= (attacks & p->pieceBB[W_BISHOP]);
+	attacks = rookAttacks(p, square);
+	validAttacks |= (attacks & p->pieceBB[W_ROOK]);
+	attacks = queenAttacks(p, square);
+	validAttacks |= (attacks & p->pieceBB[W_QUEEN]);
+	attacks = KING_ATTACKS[square];
+	validAttacks |= (attacks & p->pieceBB[W_KING]);
+	return (validAttacks > 0);
+}
+
+// The pieces of colour attacking square
+uint64_t attackersOf(Position* p, int square, int colour) {
+	uint64_t pawnAttacks = (colour == WHITE) ? blackPawnAttacks(square) : whitePawnAttacks(square);
+	uint64_t diagonals = p->pieceBB[W_BISHOP + 6*colour] | p->pieceBB[W_QUEEN + 6*colour];
+	uint64_t straights = p->pieceBB[W_ROOK + 6*colour] | p->pieceBB[W_QUEEN + 6*colour];
+	return (pawnAttacks & p->pieceBB[W_PAWN + 6*colour])
+		| (KNIGHT_ATTACKS[square] & p->pieceBB[W_KNIGHT + 6*colour])
+		| (bishopAttacks(p, square) & diagonals)
+		| (rookAttacks(p, square) & straights)
+		| (KING_ATTACKS[square] & p->pieceBB[W_KING + 6*colour]);
+}
+
+// The enemy pieces giving check to the side to move
+uint64_t getCheckers(Position* p) {
+	return attackersOf(p, LOG2(p->pieceBB[W_KING + 6*p->player]), !p->player);
+}
+
+void removalIllegalWhiteMoves(MoveList* ml, Position* p, IrrFlagStack* fs) {
+
+	int keepFlags[ml->used];
+	int i, j;
+	for(i=0; i<ml->used; i++) {
+		keepFlags[i] = TRUE;
+		if(ml->list[i].piece == W_KING) {
+			continue;
+		}
+		makeMove(p, &ml->list[i], fs);
+		if(attackedByBlack(p, p->pieceBB[W_KING])) {
+			keepFlags[i] = FALSE;
+		}
+		unmakeMove(p, &ml->list[i], fs);
+	}
+	j=0;
+	for(i=0; i<ml->used; i++) {
+		if(keepFlags[i]) {
+			ml->list[j++] = ml->list[i];
+		}
+	}
+	ml->used = j;
+
+}
+
+void removalIllegalBlackMoves(MoveList* ml, Position* p, IrrFlagStack* fs) {
+	// int removalCount;
+	int keepFlags[ml->used];
+	int i, j;
+	for(i=0; i<ml->used; i++) {
+		keepFlags[i] = TRUE;
+		if(ml->list[i].piece == B_KING) {
+			continue;
+		}
+		makeMove(p, &ml->list[i], fs);
+
+		if(attackedByWhite(p, p->pieceBB[B_KING])) {
+			keepFlags[i] = FALSE;
+
+		}
+		unmakeMove(p, &ml->list[i], fs);
+	}
+	j=0;
+	for(i=0; i<ml->used; i++) {
+		if(keepFlags[i]) {
+			ml->list[j++] = ml->list[i];
+		}
+	}
+	ml->used = j;
+}
+
+void genLegalMoves(MoveList* ml, Position* p, IrrFlagStack* fs) {
+	uint64_t checkers = getCheckers(p);
+	if(checkers) {
+		genEvasions(ml, p, checkers);
+	} else {
+		genMoves(ml, p);
+	}
+	if(p->player == WHITE) {
+		removalIllegalWhiteMoves(ml, p, fs);
+	} else {
+		removalIllegalBlackMoves(ml, p, fs);
+	}
+}
+
+void genCaptures(MoveList* ml, Position* p, IrrFlagStack* fs) {
+	initMoveList(ml, 8);
+	if(p->player == WHITE) {
+		genWhiteCaptures(ml, p);
+		removalIllegalWhiteMoves(ml, p, fs);
+	} else {
+		genBlackCaptures(ml, p);
+		removalIllegalBlackMoves(ml, p, fs);
+	}
+}
+
+// Legal captures, promotions and quiet checks, for quiescence
+void genCapturesAndChecks(MoveList* ml, Position* p, IrrFlagStack* fs) {
+	initMoveList(ml, 16);
+	if(p->player == WHITE) {
+		genWhiteCaptures(ml, p);
+		genQuietCheckMoves(ml, p, WHITE);
+		removalIllegalWhiteMoves(ml, p, fs);
+	} else {
+		genBlackCaptures(ml, p);
+		genQuietCheckMoves(ml, p, BLACK);
+		removalIllegalBlackMoves(ml, p, fs);
+	}
+}
+
+// Move createMoveFromAlgebraic(char* s, Position* b, IrrFlagStack* fs) {
+// 	int from = algebraicToIndex(s);
+// 	int to = algebraicToIndex(&s[2]);
+// 	if(s[4] != 0) {
+// 		int promotionPiece = charToPiece(s[4]);
+// 		return createSpecialMove(from, to, 0, 0, promotionPiece, b);
+// 	}
+// 	return createMove(from, to, b);
+// }
+
+int scoreFinalPosition(Position* p) {
+	int res = attackedByWhite(p, p->pieceBB[B_KING]);
+	res += attackedByBlack(p, p->pieceBB[W_KING]) << 1;
+	return res;
+}
+
+int finalResult(Position* p) {
+	int res = scoreFinalPosition(p);
+	switch(res) {
+		case 0:
+			return RES_STALEMATE;
+		case 1:
+			return RES_WHITE_WIN;
+		case 2:
+			return RES_BLACK_WIN;
+		default:
+			return RES_UNFINISHED;
+	}
+}
+
+long perft(Position* b, IrrFlagStack* fs, int depth) {
+	if(depth == 0) {
+		return 1;
+	} else {
+		MoveList ml;
+		Move m;
+		genLegalMoves(&ml, b, fs);
+		if(ml.used == 0) {
+			return 0;
+		}
+		int i;
+		long total = 0;
+		for(i=0; i<ml.used; i++) {
+			m = ml.list[i];
+			makeMove(b, &m, fs);
+
+
+			total += perft(b, fs, depth - 1);
+			unmakeMove(b, &m, fs);
+			if(depth == 6) {
+				outputMove(&m, FALSE);
+			}
+		}
+		freeMoveList(&ml);
+		if(depth == 5) {
+			printf("\t%ld\n", total);
+		}
+		return total;
+	}
+}
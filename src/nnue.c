@@ -0,0 +1,360 @@
+// NNUE evaluation, see NnueHeader for the network file format
+#include "chess-b.h"
+
+// Reads a network file made by trainers or by ./chess-b gennet, mapping it
+// rather than copying so that several engine processes share one copy
+int loadNnueNetwork(NnueNetwork* net, const char* path) {
+	struct stat st;
+	const char* base;
+	const NnueHeader* header;
+	size_t expectedSize = sizeof(NnueHeader)
+		+ NNUE_INPUTS * NNUE_HIDDEN * sizeof(int16_t) + NNUE_HIDDEN * sizeof(int16_t)
+		+ NNUE_L2 * sizeof(int32_t) + NNUE_L2 * 2 * NNUE_HIDDEN * sizeof(int8_t)
+		+ sizeof(int32_t) + NNUE_L2 * sizeof(int8_t);
+
+	int fd = open(path, O_RDONLY);
+	if(fd < 0) {
+		printf("ERROR: CANNOT OPEN NETWORK %s\n", path); return FALSE;
+	}
+	if(fstat(fd, &st) != 0 || (size_t) st.st_size != expectedSize) {
+		printf("ERROR: NETWORK %s HAS WRONG SIZE\n", path);
+		close(fd); return FALSE;
+	}
+	net->mapping = mmap(NULL, expectedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if(net->mapping == MAP_FAILED) {
+		printf("ERROR: MMAP FAILED\n"); return FALSE;
+	}
+	net->mappingSize = expectedSize;
+
+	header = (const NnueHeader*) net->mapping;
+	if(memcmp(header->magic, "CCNN", 4) != 0 || header->version != NNUE_VERSION
+		|| header->inputs != NNUE_INPUTS || header->hidden != NNUE_HIDDEN || header->l2 != NNUE_L2) {
+		printf("ERROR: NETWORK %s HAS WRONG FORMAT\n", path);
+		freeNnueNetwork(net); return FALSE;
+	}
+
+	base = (const char*) net->mapping + sizeof(NnueHeader);
+	net->featureWeights = (const int16_t*) base;
+	base += NNUE_INPUTS * NNUE_HIDDEN * sizeof(int16_t);
+	net->featureBiases = (const int16_t*) base;
+	base += NNUE_HIDDEN * sizeof(int16_t);
+	net->l2Biases = (const int32_t*) base;
+	base += NNUE_L2 * sizeof(int32_t);
+	net->l2Weights = (const int8_t*) base;
+	base += NNUE_L2 * 2 * NNUE_HIDDEN * sizeof(int8_t);
+	net->outputBias = (const int32_t*) base;
+	base += sizeof(int32_t);
+	net->outputWeights = (const int8_t*) base;
+	return TRUE;
+}
+
+void freeNnueNetwork(NnueNetwork* net) {
+	munmap(net->mapping, net->mappingSize);
+	net->mapping = NULL;
+}
+
+// Writes a network of small random weights. It plays badly, but exercises
+// exactly the same code as a trained one, so is enough for benchmarking
+int writeRandomNnueNetwork(const char* path, uint64_t seed) {
+	NnueHeader header;
+	int i;
+	int16_t w16;
+	int32_t w32;
+	int8_t w8;
+	FILE* f = fopen(path, "wb");
+	if(f == NULL) {
+		printf("ERROR: CANNOT OPEN %s\n", path); return FALSE;
+	}
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, "CCNN", 4);
+	header.version = NNUE_VERSION;
+	header.inputs = NNUE_INPUTS;
+	header.hidden = NNUE_HIDDEN;
+	header.l2 = NNUE_L2;
+	fwrite(&header, sizeof(header), 1, f);
+
+	for(i=0; i<NNUE_INPUTS * NNUE_HIDDEN; i++) {
+		w16 = (int16_t)(xorshift64(&seed) % 33) - 16;
+		fwrite(&w16, sizeof(w16), 1, f);
+	}
+	for(i=0; i<NNUE_HIDDEN; i++) {
+		w16 = (int16_t)(xorshift64(&seed) % 33);
+		fwrite(&w16, sizeof(w16), 1, f);
+	}
+	for(i=0; i<NNUE_L2; i++) {
+		w32 = 0;
+		fwrite(&w32, sizeof(w32), 1, f);
+	}
+	for(i=0; i<NNUE_L2 * 2 * NNUE_HIDDEN; i++) {
+		w8 = (int8_t)(xorshift64(&seed) % 65) - 32;
+		fwrite(&w8, sizeof(w8), 1, f);
+	}
+	w32 = 0;
+	fwrite(&w32, sizeof(w32), 1, f);
+	for(i=0; i<NNUE_L2; i++) {
+		w8 = (int8_t)(xorshift64(&seed) % 65) - 32;
+		fwrite(&w8, sizeof(w8), 1, f);
+	}
+	fclose(f);
+	return TRUE;
+}
+
+// dst = src + each of addRows - each of subRows, over one perspective
+void nnueApplyDeltas(int16_t* dst, const int16_t* src, const int16_t** addRows, int adds, const int16_t** subRows, int subs) {
+	int i, j;
+#if defined(__AVX2__)
+	__m256i v;
+	for(i=0; i<NNUE_HIDDEN; i+=16) {
+		v = _mm256_loadu_si256((const __m256i*)(src + i));
+		for(j=0; j<adds; j++) {
+			v = _mm256_add_epi16(v, _mm256_loadu_si256((const __m256i*)(addRows[j] + i)));
+		}
+		for(j=0; j<subs; j++) {
+			v = _mm256_sub_epi16(v, _mm256_loadu_si256((const __m256i*)(subRows[j] + i)));
+		}
+		_mm256_storeu_si256((__m256i*)(dst + i), v);
+	}
+#elif defined(__SSSE3__)
+	__m128i v;
+	for(i=0; i<NNUE_HIDDEN; i+=8) {
+		v = _mm_loadu_si128((const __m128i*)(src + i));
+		for(j=0; j<adds; j++) {
+			v = _mm_add_epi16(v, _mm_loadu_si128((const __m128i*)(addRows[j] + i)));
+		}
+		for(j=0; j<subs; j++) {
+			v = _mm_sub_epi16(v, _mm_loadu_si128((const __m128i*)(subRows[j] + i)));
+		}
+		_mm_storeu_si128((__m128i*)(dst + i), v);
+	}
+#else
+	int16_t v;
+	for(i=0; i<NNUE_HIDDEN; i++) {
+		v = src[i];
+		for(j=0; j<adds; j++) {
+			v += addRows[j][i];
+		}
+		for(j=0; j<subs; j++) {
+			v -= subRows[j][i];
+		}
+		dst[i] = v;
+	}
+#endif
+}
+
+// Clamps to [0, 127] and narrows to bytes
+void nnueClippedRelu(uint8_t* output, const int16_t* input) {
+	int i;
+#if defined(__AVX2__)
+	const __m256i zero = _mm256_setzero_si256();
+	__m256i a, b;
+	for(i=0; i<NNUE_HIDDEN; i+=32) {
+		a = _mm256_max_epi16(_mm256_loadu_si256((const __m256i*)(input + i)), zero);
+		b = _mm256_max_epi16(_mm256_loadu_si256((const __m256i*)(input + i + 16)), zero);
+		// packs saturates at 127 but works within 128 bit lanes, so the
+		// permute puts the 64 bit halves back in order
+		_mm256_storeu_si256((__m256i*)(output + i), _mm256_permute4x64_epi64(_mm256_packs_epi16(a, b), 0xD8));
+	}
+#elif defined(__SSSE3__)
+	const __m128i zero = _mm_setzero_si128();
+	__m128i a, b;
+	for(i=0; i<NNUE_HIDDEN; i+=16) {
+		a = _mm_max_epi16(_mm_loadu_si128((const __m128i*)(input + i)), zero);
+		b = _mm_max_epi16(_mm_loadu_si128((const __m128i*)(input + i + 8)), zero);
+		_mm_storeu_si128((__m128i*)(output + i), _mm_packs_epi16(a, b));
+	}
+#else
+	for(i=0; i<NNUE_HIDDEN; i++) {
+		output[i] = (input[i] < 0) ? 0 : (input[i] > 127) ? 127 : input[i];
+	}
+#endif
+}
+
+// Hidden layer: uint8 inputs times int8 weights, summed into int32. Inputs
+// are at most 127, so maddubs can never saturate
+void nnueHiddenLayer(int32_t* output, const uint8_t* input, const int8_t* weights, const int32_t* biases) {
+	int i, j;
+	const int8_t* row;
+#if defined(__AVX2__)
+	const __m256i ones = _mm256_set1_epi16(1);
+	__m256i sum;
+	__m128i sum128;
+	for(j=0; j<NNUE_L2; j++) {
+		row = weights + j * 2 * NNUE_HIDDEN;
+		sum = _mm256_setzero_si256();
+		for(i=0; i<2*NNUE_HIDDEN; i+=32) {
+			sum = _mm256_add_epi32(sum, _mm256_madd_epi16(_mm256_maddubs_epi16(
+				_mm256_loadu_si256((const __m256i*)(input + i)),
+				_mm256_loadu_si256((const __m256i*)(row + i))), ones));
+		}
+		sum128 = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+		sum128 = _mm_add_epi32(sum128, _mm_shuffle_epi32(sum128, 0x4E));
+		sum128 = _mm_add_epi32(sum128, _mm_shuffle_epi32(sum128, 0xB1));
+		output[j] = biases[j] + _mm_cvtsi128_si32(sum128);
+	}
+#elif defined(__SSSE3__)
+	const __m128i ones = _mm_set1_epi16(1);
+	__m128i sum;
+	for(j=0; j<NNUE_L2; j++) {
+		row = weights + j * 2 * NNUE_HIDDEN;
+		sum = _mm_setzero_si128();
+		for(i=0; i<2*NNUE_HIDDEN; i+=16) {
+			sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_maddubs_epi16(
+				_mm_loadu_si128((const __m128i*)(input + i)),
+				_mm_loadu_si128((const __m128i*)(row + i))), ones));
+		}
+		sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+		sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+		output[j] = biases[j] + _mm_cvtsi128_si32(sum);
+	}
+#else
+	int32_t sum;
+	for(j=0; j<NNUE_L2; j++) {
+		row = weights + j * 2 * NNUE_HIDDEN;
+		sum = biases[j];
+		for(i=0; i<2*NNUE_HIDDEN; i++) {
+			sum += input[i] * row[i];
+		}
+		output[j] = sum;
+	}
+#endif
+}
+
+// Weights for piece on square, as seen by perspective. Black sees the board
+// flipped with the colours swapped, so one set of weights serves both sides
+const int16_t* nnueFeatureRow(const NnueNetwork* net, int perspective, int piece, int square) {
+	if(perspective == BLACK) {
+		piece += (piece >= B_PAWN) ? -6 : 6;
+		square ^= 56;
+	}
+	return net->featureWeights + ((piece - W_PAWN) * 64 + square) * NNUE_HIDDEN;
+}
+
+void initNnueStack(NnueAccumulatorStack* st, int initSize) {
+	st->list = malloc(initSize * sizeof(NnueAccumulator));
+	if(st->list == NULL) {
+		printf("ERROR: MALLOC FAILED\n"); return;
+	}
+	st->used = 0;
+	st->size = initSize;
+}
+
+void freeNnueStack(NnueAccumulatorStack* st) {
+	free(st->list);
+	st->list = NULL;
+}
+
+// Rebuild the accumulator from the pieces on the board, as the only entry
+void refreshNnueStack(NnueAccumulatorStack* st, const NnueNetwork* net, Position* p) {
+	const int16_t* rows[32];
+	int locs[64];
+	int perspective, piece, i, n, count;
+	for(perspective=WHITE; perspective<=BLACK; perspective++) {
+		count = 0;
+		for(piece=W_PAWN; piece<=B_KING; piece++) {
+			n = serialiseBoard(locs, p->pieceBB[piece]);
+			for(i=0; i<n && count<32; i++) {
+				rows[count++] = nnueFeatureRow(net, perspective, piece, locs[i]);
+			}
+		}
+		nnueApplyDeltas(st->list[0].values[perspective], net->featureBiases, rows, count, NULL, 0);
+	}
+	st->used = 1;
+}
+
+// Push the accumulator after m, from the one before it. Only the features m
+// changes are touched. Called before makeMove updates p
+void pushNnueMove(NnueAccumulatorStack* st, const NnueNetwork* net, Position* p, Move* m) {
+	int addPieces[2], addSquares[2], subPieces[2], subSquares[2];
+	const int16_t* addRows[2];
+	const int16_t* subRows[2];
+	int adds = 0, subs = 0;
+	int perspective, i;
+	int rook = W_ROOK+(6*m->colour);
+	int landing = m->piece;
+
+	if(st->used == 0) {
+		refreshNnueStack(st, net, p);
+	}
+	if(st->used == st->size) {
+		st->size *= 2;
+		st->list = realloc(st->list, st->size * sizeof(NnueAccumulator));
+		if(st->list == NULL) {
+			printf("ERROR: REALLOC FAILED\n"); return;
+		}
+	}
+
+	switch(m->flags) {
+		case FLAG_KNIGHT_PROMO:
+		case FLAG_KNIGHT_PROMO_CAPT:
+			landing = W_KNIGHT+(6*m->colour); break;
+		case FLAG_BISHOP_PROMO:
+		case FLAG_BISHOP_PROMO_CAPT:
+			landing = W_BISHOP+(6*m->colour); break;
+		case FLAG_ROOK_PROMO:
+		case FLAG_ROOK_PROMO_CAPT:
+			landing = W_ROOK+(6*m->colour); break;
+		case FLAG_QUEEN_PROMO:
+		case FLAG_QUEEN_PROMO_CAPT:
+			landing = W_QUEEN+(6*m->colour); break;
+	}
+	subPieces[subs] = m->piece; subSquares[subs++] = m->from;
+	addPieces[adds] = landing; addSquares[adds++] = m->to;
+
+	if(m->flags & (FLAG_CAPTURES|FLAG_KNIGHT_PROMO_CAPT|FLAG_BISHOP_PROMO_CAPT|FLAG_ROOK_PROMO_CAPT|FLAG_QUEEN_PROMO_CAPT)) {
+		subPieces[subs] = m->cPiece; subSquares[subs++] = m->to;
+	} else if(m->flags == FLAG_EP_CAPTURE) {
+		subPieces[subs] = m->cPiece; subSquares[subs++] = p->flag.enPassantFlag;
+	} else if(m->flags == FLAG_KING_CASTLE) {
+		subPieces[subs] = rook; subSquares[subs++] = m->to+1; // H1/H8
+		addPieces[adds] = rook; addSquares[adds++] = m->from+1; // F1/F8
+	} else if(m->flags == FLAG_QUEEN_CASTLE) {
+		subPieces[subs] = rook; subSquares[subs++] = m->to-2; // A1/A8
+		addPieces[adds] = rook; addSquares[adds++] = m->from-1; // D1/D8
+	}
+
+	for(perspective=WHITE; perspective<=BLACK; perspective++) {
+		for(i=0; i<adds; i++) {
+			addRows[i] = nnueFeatureRow(net, perspective, addPieces[i], addSquares[i]);
+		}
+		for(i=0; i<subs; i++) {
+			subRows[i] = nnueFeatureRow(net, perspective, subPieces[i], subSquares[i]);
+		}
+		nnueApplyDeltas(st->list[st->used].values[perspective], st->list[st->used-1].values[perspective], addRows, adds, subRows, subs);
+	}
+	st->used++;
+}
+
+// Popping past the last refresh empties the stack, and the next use
+// rebuilds it from the position
+void popNnueMove(NnueAccumulatorStack* st) {
+	if(st->used > 0) {
+		st->used--;
+	}
+}
+
+// Network output in centipawns, from white's point of view
+int nnueEval(Position* p) {
+	NnueAccumulator* acc;
+	uint8_t input[2*NNUE_HIDDEN] __attribute__((aligned(32)));
+	int32_t hidden[NNUE_L2];
+	Evaluator* e = p->evaluator;
+	int32_t output = *e->nnueNetwork.outputBias;
+	int i, h;
+
+	if(e->nnueStack.used == 0) {
+		refreshNnueStack(&e->nnueStack, &e->nnueNetwork, p);
+	}
+	acc = &e->nnueStack.list[e->nnueStack.used-1];
+	// Side to move's half first
+	nnueClippedRelu(input, acc->values[p->player]);
+	nnueClippedRelu(input + NNUE_HIDDEN, acc->values[!p->player]);
+	nnueHiddenLayer(hidden, input, e->nnueNetwork.l2Weights, e->nnueNetwork.l2Biases);
+	for(i=0; i<NNUE_L2; i++) {
+		h = hidden[i] >> NNUE_L2_SHIFT;
+		h = (h < 0) ? 0 : (h > 127) ? 127 : h;
+		output += h * e->nnueNetwork.outputWeights[i];
+	}
+	output /= NNUE_OUTPUT_SCALE;
+	return (p->player == WHITE) ? output : -output;
+}
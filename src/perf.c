@@ -0,0 +1,101 @@
+// Hardware performance counters for --perf (Linux only)
+#include "chess-b.h"
+
+// Hardware counters, read with perf_event_open around perft and searches
+// when --perf is given. Counters the kernel or CPU won't provide are skipped
+int openPerfCounters(PerfCounters* pc) {
+	int available = 0;
+#ifdef __linux__
+	struct perf_event_attr attr;
+	uint32_t types[PERF_COUNTER_COUNT] = {PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE};
+	uint64_t configs[PERF_COUNTER_COUNT] = {
+		PERF_COUNT_HW_CPU_CYCLES,
+		PERF_COUNT_HW_INSTRUCTIONS,
+		PERF_COUNT_HW_BRANCH_MISSES,
+		PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+		PERF_COUNT_HW_CACHE_MISSES // Last level
+	};
+	int i;
+	for(i=0; i<PERF_COUNTER_COUNT; i++) {
+		memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = types[i];
+		attr.config = configs[i];
+		attr.disabled = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		// More counters than the PMU has are time multiplexed, so ask for
+		// the times needed to scale the counts back up
+		attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+		pc->fds[i] = (int) syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+		if(pc->fds[i] >= 0) {
+			available++;
+		}
+	}
+#else
+	int i;
+	for(i=0; i<PERF_COUNTER_COUNT; i++) {
+		pc->fds[i] = -1;
+	}
+#endif
+	if(available == 0) {
+		printf("Hardware counters unavailable (needs Linux and perf_event_paranoid <= 2)\n");
+	}
+	return available;
+}
+
+void startPerfCounters(PerfCounters* pc) {
+#ifdef __linux__
+	int i;
+	for(i=0; i<PERF_COUNTER_COUNT; i++) {
+		if(pc->fds[i] >= 0) {
+			ioctl(pc->fds[i], PERF_EVENT_IOC_RESET, 0);
+			ioctl(pc->fds[i], PERF_EVENT_IOC_ENABLE, 0);
+		}
+	}
+#endif
+}
+
+void stopPerfCounters(PerfCounters* pc) {
+	int i;
+	uint64_t data[3]; // Value, time enabled, time running
+	for(i=0; i<PERF_COUNTER_COUNT; i++) {
+		pc->values[i] = 0;
+#ifdef __linux__
+		if(pc->fds[i] < 0) {
+			continue;
+		}
+		ioctl(pc->fds[i], PERF_EVENT_IOC_DISABLE, 0);
+		if(read(pc->fds[i], data, sizeof(data)) == sizeof(data) && data[2] > 0) {
+			pc->values[i] = (uint64_t)((double) data[0] * data[1] / data[2]);
+		}
+#endif
+	}
+}
+
+void outputPerfCounters(PerfCounters* pc, uint64_t nodes) {
+	const char* names[PERF_COUNTER_COUNT] = {"cycles", "instructions", "branch-misses", "L1d-misses", "LLC-misses"};
+	int i;
+	nodes = (nodes > 0) ? nodes : 1;
+	printf("%-14s %16s %12s\n", "counter", "total", "per node");
+	for(i=0; i<PERF_COUNTER_COUNT; i++) {
+		if(pc->fds[i] < 0) {
+			printf("%-14s %16s\n", names[i], "n/a");
+		} else {
+			printf("%-14s %16" PRIu64 " %12.2f\n", names[i], pc->values[i], (double) pc->values[i] / nodes);
+		}
+	}
+	if(pc->fds[0] >= 0 && pc->fds[1] >= 0 && pc->values[0] > 0) {
+		printf("IPC: %.2f\n", (double) pc->values[1] / pc->values[0]);
+	}
+}
+
+void closePerfCounters(PerfCounters* pc) {
+	int i;
+	for(i=0; i<PERF_COUNTER_COUNT; i++) {
+		if(pc->fds[i] >= 0) {
+			close(pc->fds[i]);
+		}
+		pc->fds[i] = -1;
+	}
+}
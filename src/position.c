@@ -0,0 +1,1389 @@
+// Positions: setup, Zobrist hashing, makeMove/unmakeMove and printing
+#include "chess-b.h"
+
+void initIrrFlagStack(IrrFlagStack* fs, int initSize) {
+	fs->list = malloc(initSize * sizeof(IrrFlag));
+	if(fs->list == NULL) {
+		printf("ERROR: MALLOC FAILED\n"); return;
+	}
+	fs->used = 0;
+	fs->size = initSize;
+}
+
+void pushIrrFlagStack(IrrFlagStack* fs, Position* p) {
+	if(fs->used == fs->size) {
+		fs->size *= 2;
+		fs->list = realloc(fs->list, fs->size * sizeof(IrrFlag));
+		if(fs->list == NULL) {
+			printf("ERROR: REALLOC FAILED\n"); return;
+		}
+	}
+	fs->list[fs->used++] = p->flag;
+}
+
+// Push another IrrFlag to fs, expanding as needed
+void pushIrrFlagStackReference(IrrFlagStack* fs, IrrFlag* b) {
+	if(fs->used == fs->size) {
+		fs->size *= 2;
+		fs->list = realloc(fs->list, fs->size * sizeof(IrrFlag));
+		if(fs->list == NULL) {
+			printf("ERROR: REALLOC FAILED\n"); return;
+		}
+	}
+	fs->list[fs->used++] = *b;
+}
+
+// Remove and return IrrFlag from top of fs
+IrrFlag popIrrFlagStack(IrrFlagStack* fs) {
+	if(fs->used == 0) {
+		IrrFlag f;
+		printf("ERROR: EMPTY STACK"); return f;
+	}
+	return fs->list[--(fs->used)];
+}
+
+// Reset fs, freeing memory
+void freeIrrFlagStack(IrrFlagStack* fs) {
+	free(fs->list);
+	fs->list = NULL;
+	fs->used = fs->size = 0;
+}
+
+char fileNumToChar(int f) {
+	return 'a' + f;
+}
+
+char rankNumToChar(int r) {
+	return '1' + r;
+}
+
+void indexToAlgebraic(char* s, int ind) {
+	int file = ind % 8;
+	int rank = ind / 8;
+	s[0] = fileNumToChar(file);
+	s[1] = rankNumToChar(rank);
+}
+
+char playerToChar(int player) {
+	return (player == WHITE) ? 'W' : 'b';
+}
+
+int squareToRank(int square) {
+	return square & 7;
+}
+
+int squareToFile(int square) {
+	return square >> 3;
+}
+
+char pieceToChar(int piece) {
+	switch(piece) {
+		case W_PAWN:
+			return 'P';
+		case W_KNIGHT:
+			return 'N';
+		case W_BISHOP:
+			return 'B';
+		case W_ROOK:
+			return 'R';
+		case W_QUEEN:
+			return 'Q';
+		case W_KING:
+			return 'K';
+		case B_PAWN:
+			return 'p';
+		case B_KNIGHT:
+			return 'n';
+		case B_BISHOP:
+			return 'b';
+		case B_ROOK:
+			return 'r';
+		case B_QUEEN:
+			return 'q';
+		case B_KING:
+			return 'k';
+		default:
+			return '-';
+	}
+}
+
+void moveToString(char* s, Move* m) {
+	indexToAlgebraic(s, m->from);
+	indexToAlgebraic(&s[2], m->to);
+}
+
+// Long algebraic notation as used by UCI, e.g. e2e4 or e7e8q. s needs room
+// for 6 chars, including the terminator
+void moveToUci(char* s, Move* m) {
+	moveToString(s, m);
+	s[4] = '\0';
+	s[5] = '\0';
+	if(m->flags & (FLAG_KNIGHT_PROMO|FLAG_KNIGHT_PROMO_CAPT)) {
+		s[4] = 'n';
+	} else if(m->flags & (FLAG_BISHOP_PROMO|FLAG_BISHOP_PROMO_CAPT)) {
+		s[4] = 'b';
+	} else if(m->flags & (FLAG_ROOK_PROMO|FLAG_ROOK_PROMO_CAPT)) {
+		s[4] = 'r';
+	} else if(m->flags & (FLAG_QUEEN_PROMO|FLAG_QUEEN_PROMO_CAPT)) {
+		s[4] = 'q';
+	}
+}
+
+// Finds the legal move written s in UCI notation, returning FALSE if there
+// isn't one
+int findUciMove(Position* p, IrrFlagStack* fs, const char* s, Move* m) {
+	MoveList ml;
+	char uci[6];
+	int i, found = FALSE;
+	genLegalMoves(&ml, p, fs);
+	for(i=0; i<ml.used && !found; i++) {
+		moveToUci(uci, &ml.list[i]);
+		if(strcmp(uci, s) == 0) {
+			*m = ml.list[i];
+			found = TRUE;
+		}
+	}
+	freeMoveList(&ml);
+	return found;
+}
+
+void outputMove(Move* m, int full) {
+	char s[4];
+	moveToString(s, m);
+	printf("%c%c%c%c", s[0], s[1], s[2], s[3]);
+	if(full) {
+		printf("flags : %d\n",m->flags);
+		printf("piece : %c\n",pieceToChar(m->piece));
+		printf("colour : %c\n",playerToChar(m->colour));
+		printf("cPiece : %c\n",pieceToChar(m->cPiece));
+		printf("cColour : %c\n",playerToChar(m->cColour));
+	}
+
+}
+
+void outputMoveList(MoveList* ml, char sep, int full) {
+	int i;
+	Move m;
+	for(i=0; i<ml->used; i++) {
+		if((i>0)&&(i % 10 == 0) && (sep != '\n')) {
+			printf("\n");
+		}
+		m = ml->list[i];
+		printf("%2d:",i+1);
+		outputMove(&m, full);
+		printf("%c",sep);
+
+	}
+}
+
+uint64_t getPieceBB(Position* pos, int p) {
+	return pos->pieceBB[p];
+}
+
+uint64_t getEmptyBB(Position* pos) {
+	return pos->emptyBB;
+}
+
+uint64_t getOccupiedBB(Position* pos) {
+	return pos->occupiedBB;
+}
+
+void genColourBBs(Position* pos) {
+	pos->pieceBB[WHITE] = 0;
+	int i;
+	for(i=W_PAWN; i<=W_KING; i++) {
+		pos->pieceBB[WHITE] |= pos->pieceBB[i];
+	}
+	pos->pieceBB[BLACK] = 0;
+	for(i=B_PAWN; i<=B_KING; i++) {
+		pos->pieceBB[BLACK] |= pos->pieceBB[i];
+	}
+}
+
+void genOcccupied(Position* pos) {
+	pos->occupiedBB = pos->pieceBB[WHITE] | pos->pieceBB[BLACK];
+	pos->emptyBB = ~pos->occupiedBB;
+}
+
+void setSquare(Position* pos, uint64_t square, int piece) {
+	pos->pieceBB[piece] |= square;
+}
+
+void outputBitBoard(uint64_t bb) {
+	int rankNum, bit;
+	uint64_t rank;
+	printf("\n");
+	for(rankNum = 7; rankNum>=0; rankNum--) {
+		printf("%c",rankNumToChar(rankNum));
+		rank = (bb >> (rankNum*8)) & 255;
+		for(bit=0; bit<8; bit++) {
+			if(rank&(ONE64BIT<<bit)) {
+				printf("X");
+			} else {
+				printf("-");
+			}
+		}
+		printf("\n");
+	}
+	printf(" abcdefgh\n");
+
+}
+
+void outputAttackCounts(unsigned char* counts) {
+	int i;
+	for(i=0; i<128; i++) {
+		printf("%02d ", (int) counts[i]);
+		if(i%8==7) {
+			printf("\n");
+		}
+		if(i==63) {
+			printf("\n\n");
+		}
+	}
+	printf("\n");
+}
+
+void outputMeta(Position* p) {
+	outputBitBoard(getPieceBB(p, WHITE));
+	outputBitBoard(getPieceBB(p, BLACK));
+	outputBitBoard(getOccupiedBB(p));
+	outputBitBoard(getEmptyBB(p));
+}
+
+void outputIrrFlag(IrrFlag flag) {
+	if(flag.castlingFlags&W_KSIDE_CASTLE) {
+		printf("K");
+	} else {
+		printf("-");
+	}
+	if(flag.castlingFlags&W_QSIDE_CASTLE) {
+		printf("Q");
+	} else {
+		printf("-");
+	}
+	if(flag.castlingFlags&B_KSIDE_CASTLE) {
+		printf("k");
+	} else {
+		printf("-");
+	}
+	if(flag.castlingFlags&B_QSIDE_CASTLE) {
+		printf("q");
+	} else {
+		printf("-");
+	}
+	printf(" e.p.=%d ply=%d\n", flag.enPassantFlag, flag.plyCount);
+}
+
+void outputPosition(Position* p) {
+	int piece, rank, squareNum, filled;
+	uint64_t square;
+	printf("\n");
+	for(rank=7; rank>=0; rank--) {
+		for(squareNum=rank*8; squareNum<(rank*8)+8; squareNum++) {
+			if(squareNum % 8 == 0) {
+				printf("|%c",rankNumToChar(squareNum/8));
+			}
+			filled = FALSE;
+			square = (ONE64BIT << squareNum);
+			for(piece=2; piece<14; piece++) {
+				if(p->pieceBB[piece] & square) {
+					printf("|%c", pieceToChar(piece));
+					filled = TRUE; break;
+				}
+			}
+			if(!filled) {
+				printf("|.");
+			}
+			if(squareNum % 8 == 7) {
+				printf("\n");
+			}
+		}
+	}
+	printf(" %c", playerToChar(p->player));
+	printf("|a|b|c|d|e|f|g|h\n");
+	outputIrrFlag(p->flag);
+	printf("Material:%d/%d Square vals:%d/%d Phase:%d\n", mgScore(p->materialCount), egScore(p->materialCount), mgScore(p->squareValueTotal), egScore(p->squareValueTotal), p->phase);
+	printf("Zobrist hash: %d\n", p->hash);
+	// outputMeta(p);
+}
+
+void outputAttackMaps(Position* p) {
+	char square[2];
+	char* ptr = &square[0];
+	for(int i=0; i<64; i++) {
+		indexToAlgebraic(ptr, i);
+		printf("Square: %c%c\n",square[0], square[1]);
+		outputBitBoard(p->squareAttacksBB[i]);
+	}
+}
+
+void initialisePosition(Position* p, Evaluator* e) {
+	int i;
+	for(i=0; i<14; i++) {
+		p->pieceBB[i] = 0;
+	}
+	p->emptyBB = 0;
+	p->occupiedBB = 0;
+	p->evaluator = e;
+
+	p->squareValueTotal = 0;
+	// }
+	p->materialCount = 0;
+	p->phase = 0;
+	for(i=0; i<64; i++) {
+		p->squareAttacksBB[i] = 0;
+		// p->attackedBySide[i] = 0;
+		// p->attackedBySide[i+64] = 0;
+	}
+}
+
+void updateZobristPieceMove(Position* p, int piece, int square) {
+	// printf("HASH UPDATE. PIECE: %d, SQUARE: %d\n", piece, square);
+	unsigned int key = ZOBRIST_RANDOMS[((piece - 2) * 64) + square]; // Piece in range 0-11
+	p->hash ^= key;
+	if(piece == W_PAWN || piece == B_PAWN) {
+		p->pawnHash ^= key;
+	}
+}
+
+void updateZobristSideToMove(Position* p) {
+	// printf("HASH UPDATE. Side to move\n");
+	p->hash ^= ZOBRIST_RANDOMS[768];
+}
+
+void updateZobristWKCastle(Position* p) {
+	// printf("HASH UPDATE. WK\n");
+	p->hash ^= ZOBRIST_RANDOMS[769];
+}
+
+void updateZobristWQCastle(Position* p) {
+	// printf("HASH UPDATE. WQ\n");
+	p->hash ^= ZOBRIST_RANDOMS[770];
+}
+
+void updateZobristBKCastle(Position* p) {
+	// printf("HASH UPDATE. BK\n");
+	p->hash ^= ZOBRIST_RANDOMS[771];
+}
+
+void updateZobristBQCastle(Position* p) {
+	// printf("HASH UPDATE. WQ\n");
+	p->hash ^= ZOBRIST_RANDOMS[772];
+}
+
+void updateZobristCastlingFlag(Position* p, int flag) {
+	// printf("HASH UPDATE. Castling flags: %d\n", flag);
+	p->hash ^= ZOBRIST_RANDOMS[769] * (flag & 1);
+	flag >>= 1;
+	p->hash ^= ZOBRIST_RANDOMS[770] * (flag & 1);
+	flag >>= 1;
+	p->hash ^= ZOBRIST_RANDOMS[771] * (flag & 1);
+	flag >>= 1;
+	p->hash ^= ZOBRIST_RANDOMS[772] * (flag & 1);
+}
+
+void updateZobristEnPassantFlag(Position* p, int flag) {
+	if(flag == 0) return;
+	flag = flag % 8; // Get file
+	// printf("HASH UPDATE. En passant: %d\n", flag);
+	p->hash ^= ZOBRIST_RANDOMS[773+flag];
+}
+
+int calcZobristFromScratch(Position* p) {
+	// printf("CALCULATING FROM SCRATH\n");
+	int tempHash = p->hash;
+	unsigned int tempPawnHash = p->pawnHash;
+	int returnVal;
+
+	p->hash = 0;
+	int square, piece;
+	for(square=0; square<64; square++) {
+		piece = pieceOnSquare(p, square);
+		if(piece >= W_PAWN) {
+			updateZobristPieceMove(p, piece, square);
+		}
+	}
+	if(p->player == BLACK) {
+		updateZobristSideToMove(p);
+	}
+	updateZobristCastlingFlag(p, p->flag.castlingFlags);
+	if(p->flag.enPassantFlag) {
+		updateZobristEnPassantFlag(p, p->flag.enPassantFlag);
+	}
+	returnVal = p->hash;
+
+	p->hash = tempHash;
+	p->pawnHash = tempPawnHash;
+	// printf("FINISHED CALCULATING FROM SCRATH\n");
+	return returnVal;
+}
+
+int calcZobristFromScratchVerbose(Position* p) {
+	printf("CALCULATING FROM SCRATH (VERBOSE)\n");
+	int tempHash = p->hash;
+	unsigned int tempPawnHash = p->pawnHash;
+	int returnVal;
+
+	p->hash = 0;
+	int square, piece;
+	for(square=0; square<64; square++) {
+		piece = pieceOnSquare(p, square);
+		if(piece >= W_PAWN) {
+			updateZobristPieceMove(p, piece, square);
+			printf("Piece %d\n", p->hash);
+		}
+	}
+	if(p->player == BLACK) {
+		updateZobristSideToMove(p);
+		printf("Side to move %d\n", p->hash);
+	}
+	updateZobristCastlingFlag(p, p->flag.castlingFlags);
+	printf("Castling %d\n", p->hash);
+	if(p->flag.enPassantFlag) {
+		updateZobristEnPassantFlag(p, p->flag.enPassantFlag);
+	}
+	printf("En passant %d\n", p->hash);
+	returnVal = p->hash;
+
+	p->hash = tempHash;
+	p->pawnHash = tempPawnHash;
+	printf("FINISHED CALCULATING FROM SCRATH\n");
+	return returnVal;
+}
+
+void initZobristHash(Position* p) {
+	p->hash = 0;
+	p->pawnHash = 0;
+	int square, piece;
+	for(square=0; square<64; square++) {
+		piece = pieceOnSquare(p, square);
+		if(piece >= W_PAWN) {
+			updateZobristPieceMove(p, piece, square);
+		}
+	}
+	if(p->player == BLACK) {
+		updateZobristSideToMove(p);
+	}
+	updateZobristCastlingFlag(p, p->flag.castlingFlags);
+	if(p->flag.enPassantFlag) {
+		updateZobristEnPassantFlag(p, p->flag.enPassantFlag);
+	}
+}
+
+int calcPhaseFromScratch(Position* p) {
+	int piece, phase = 0;
+	for(piece=W_PAWN; piece<=B_KING; piece++) {
+		phase += popCount(p->pieceBB[piece]) * PHASE_VALUES[piece];
+	}
+	return phase;
+}
+
+// Slow
+int pieceOnSquare(Position* p, int square) {
+	int i;
+	uint64_t squareBB = SQUARE_BBS[square];
+	for(i=W_PAWN; i<=B_KING; i++) {
+		if(p->pieceBB[i] & squareBB) {
+			return i;
+		}
+	}
+	if(p->emptyBB & squareBB) {
+		return 0;
+	}
+	return -1;
+}
+
+uint64_t pieceAttacks(Position* p, int piece, int square) {
+	switch(piece) {
+		case W_PAWN:
+			return whitePawnAttacks(square);
+		case B_PAWN:
+			return blackPawnAttacks(square);
+		case W_KNIGHT:
+		case B_KNIGHT:
+			return KNIGHT_ATTACKS[square];
+		case W_BISHOP:
+		case B_BISHOP:
+			return bishopAttacks(p, square);
+		case W_ROOK:
+		case B_ROOK:
+			return rookAttacks(p, square);
+		case W_QUEEN:
+		case B_QUEEN:
+			return queenAttacks(p, square);
+		case W_KING:
+		case B_KING:
+			return KING_ATTACKS[square];
+		case 0:
+			return 0;
+		default:
+			// Shouldn't occur. Fill everything for easy debugging
+			return ~0;
+	}
+}
+
+// void genAllSquareValues(Position* p) {
+// 	int square, piece;
+// 	for(square=0; square<64; square++) {
+// 		piece = pieceOnSquare(p, square);
+// 		p->squareValue[piece][square] = PIECE_SQUARE_VALUES[piece][square];
+// 	}
+// }
+
+// Slow, only use once
+void genAllAttackMaps(Position* p) {
+	int square, piece, empty, colour;
+	for(square=0; square<64; square++) {
+		piece = pieceOnSquare(p, square);
+		empty = (p->emptyBB & SQUARE_BBS[square]) ? 2 : 0;
+		colour = (p->pieceBB[WHITE] & SQUARE_BBS[square]) ? 1 : 0;
+		colour += empty;
+		p->squareAttacksBB[square] = pieceAttacks(p, piece, square);
+	}
+}
+
+void setupStartPosition(Position* p, Evaluator* e) {
+	initialisePosition(p, e);
+	setSquare(p, A1, W_ROOK);
+	setSquare(p, B1, W_KNIGHT);
+	setSquare(p, C1, W_BISHOP);
+	setSquare(p, D1, W_QUEEN);
+	setSquare(p, E1, W_KING);
+	setSquare(p, F1, W_BISHOP);
+	setSquare(p, G1, W_KNIGHT);
+	setSquare(p, H1, W_ROOK);
+
+	setSquare(p, A8, B_ROOK);
+	setSquare(p, B8, B_KNIGHT);
+	setSquare(p, C8, B_BISHOP);
+	setSquare(p, D8, B_QUEEN);
+	setSquare(p, E8, B_KING);
+	setSquare(p, F8, B_BISHOP);
+	setSquare(p, G8, B_KNIGHT);
+	setSquare(p, H8, B_ROOK);
+
+	setSquare(p, A2, W_PAWN);
+	setSquare(p, B2, W_PAWN);
+	setSquare(p, C2, W_PAWN);
+	setSquare(p, D2, W_PAWN);
+	setSquare(p, E2, W_PAWN);
+	setSquare(p, F2, W_PAWN);
+	setSquare(p, G2, W_PAWN);
+	setSquare(p, H2, W_PAWN);
+
+	setSquare(p, A7, B_PAWN);
+	setSquare(p, B7, B_PAWN);
+	setSquare(p, C7, B_PAWN);
+	setSquare(p, D7, B_PAWN);
+	setSquare(p, E7, B_PAWN);
+	setSquare(p, F7, B_PAWN);
+	setSquare(p, G7, B_PAWN);
+	setSquare(p, H7, B_PAWN);
+
+	genColourBBs(p);
+	genOcccupied(p);
+	genAllAttackMaps(p);
+	// genAllSquareValues(p);
+
+	p->materialCount = 0;
+	p->squareValueTotal = 0;
+	p->phase = calcPhaseFromScratch(p);
+	p->player = WHITE;
+	p->flag.plyCount = 0;
+	p->flag.castlingFlags = W_KSIDE_CASTLE | W_QSIDE_CASTLE | B_KSIDE_CASTLE | B_QSIDE_CASTLE;
+	p->flag.enPassantFlag = 0;
+
+	initZobristHash(p);
+	refreshEvaluator(e, p);
+}
+
+// Whether colour's material could arise in a game: at most 8 pawns, and
+// no more pieces beyond the starting set than pawns that could have
+// promoted. Eval's fixed size square buffers rely on this
+static int reachableMaterial(Position* p, int colour) {
+	int offset = 6 * colour;
+	int pawns = popCount(p->pieceBB[W_PAWN + offset]);
+	int knights = popCount(p->pieceBB[W_KNIGHT + offset]);
+	int bishops = popCount(p->pieceBB[W_BISHOP + offset]);
+	int rooks = popCount(p->pieceBB[W_ROOK + offset]);
+	int queens = popCount(p->pieceBB[W_QUEEN + offset]);
+	int promoted = ((knights > 2) ? knights - 2 : 0) + ((bishops > 2) ? bishops - 2 : 0)
+		+ ((rooks > 2) ? rooks - 2 : 0) + ((queens > 1) ? queens - 1 : 0);
+	return pawns + promoted <= 8;
+}
+
+// Returns FALSE if fen can't be parsed or its material couldn't arise in a
+// game (see reachableMaterial, and pawns on the back ranks). Castling rights
+// without their king and rook at home are ignored. Move counters are optional
+int setupPositionFromFen(Position* p, const char* fen, Evaluator* e) {
+	const char* pieceChars = "PNBRQKpnbrqk";
+	const char* found;
+	int rank = 7, file = 0, square, piece, i, n;
+	int locs[64];
+	unsigned int plyCount = 0;
+
+	initialisePosition(p, e);
+	for(; *fen && *fen != ' '; fen++) {
+		if(*fen == '/') {
+			rank--;
+			file = 0;
+		} else if(*fen >= '1' && *fen <= '8') {
+			file += *fen - '0';
+		} else if((found = strchr(pieceChars, *fen)) != NULL && rank >= 0 && file < 8) {
+			setSquare(p, SQUARE_BBS[rank*8 + file], W_PAWN + (int)(found - pieceChars));
+			file++;
+		} else {
+			return FALSE;
+		}
+	}
+	if(popCount(p->pieceBB[W_KING]) != 1 || popCount(p->pieceBB[B_KING]) != 1) {
+		return FALSE;
+	}
+	if(((p->pieceBB[W_PAWN] | p->pieceBB[B_PAWN]) & (RANK_1 | RANK_8)) != 0) {
+		return FALSE;
+	}
+	if(!reachableMaterial(p, WHITE) || !reachableMaterial(p, BLACK)) {
+		return FALSE;
+	}
+
+	while(*fen == ' ') fen++;
+	if(*fen != 'w' && *fen != 'b') {
+		return FALSE;
+	}
+	p->player = (*fen++ == 'w') ? WHITE : BLACK;
+
+	while(*fen == ' ') fen++;
+	p->flag.castlingFlags = 0;
+	for(; *fen && *fen != ' '; fen++) {
+		switch(*fen) {
+			case 'K': p->flag.castlingFlags |= W_KSIDE_CASTLE; break;
+			case 'Q': p->flag.castlingFlags |= W_QSIDE_CASTLE; break;
+			case 'k': p->flag.castlingFlags |= B_KSIDE_CASTLE; break;
+			case 'q': p->flag.castlingFlags |= B_QSIDE_CASTLE; break;
+		}
+	}
+	// Rights whose king or rook has left its home square are dropped, as
+	// makeMove would have done, so castling can't move a missing piece
+	if(!(p->pieceBB[W_KING] & E1)) p->flag.castlingFlags &= ~(W_KSIDE_CASTLE | W_QSIDE_CASTLE);
+	if(!(p->pieceBB[B_KING] & E8)) p->flag.castlingFlags &= ~(B_KSIDE_CASTLE | B_QSIDE_CASTLE);
+	if(!(p->pieceBB[W_ROOK] & H1)) p->flag.castlingFlags &= ~W_KSIDE_CASTLE;
+	if(!(p->pieceBB[W_ROOK] & A1)) p->flag.castlingFlags &= ~W_QSIDE_CASTLE;
+	if(!(p->pieceBB[B_ROOK] & H8)) p->flag.castlingFlags &= ~B_KSIDE_CASTLE;
+	if(!(p->pieceBB[B_ROOK] & A8)) p->flag.castlingFlags &= ~B_QSIDE_CASTLE;
+
+	// FEN gives the square behind the pawn, but we store the pawn's square
+	while(*fen == ' ') fen++;
+	p->flag.enPassantFlag = 0;
+	if(fen[0] >= 'a' && fen[0] <= 'h' && fen[1] >= '1' && fen[1] <= '8') {
+		square = (fen[1] - '1') * 8 + (fen[0] - 'a');
+		p->flag.enPassantFlag = (p->player == WHITE) ? square - 8 : square + 8;
+	}
+	while(*fen && *fen != ' ') fen++;
+	sscanf(fen, "%u", &plyCount);
+	p->flag.plyCount = plyCount;
+
+	genColourBBs(p);
+	genOcccupied(p);
+	genAllAttackMaps(p);
+	for(piece=W_PAWN; piece<=B_KING; piece++) {
+		n = serialiseBoard(locs, p->pieceBB[piece]);
+		for(i=0; i<n; i++) {
+			p->materialCount += PIECE_VALUES[piece];
+			p->squareValueTotal += PIECE_SQUARE_VALUES[piece][locs[i]];
+		}
+	}
+	p->phase = calcPhaseFromScratch(p);
+
+	initZobristHash(p);
+	refreshEvaluator(e, p);
+	return TRUE;
+}
+
+Move createMove(int from, int to, int flags, int piece, int colour, int cPiece, int cColour) {
+	Move m;
+	m.from = from;
+	m.to = to;
+	m.flags = flags;
+	m.piece = piece;
+	m.colour = colour;
+	m.cPiece = cPiece;
+	m.cColour = cColour;
+	return m;
+}
+
+// The hash p will have once m is made, without making it, so that search
+// can prefetch the child's hash table entry while makeMove does the rest
+unsigned int hashAfterMove(Position* p, Move* m) {
+	uint64_t fromToBB = SQUARE_BBS[m->from] ^ SQUARE_BBS[m->to];
+	unsigned int hash = p->hash ^ ZOBRIST_RANDOMS[768];
+	int piece = m->piece;
+	int rook = W_ROOK + (6 * m->colour);
+	int lost = 0;
+
+	if(p->flag.enPassantFlag != 0) {
+		hash ^= ZOBRIST_RANDOMS[773 + p->flag.enPassantFlag % 8];
+	}
+	switch(m->flags) {
+		case FLAG_DOUBLE_PAWN_PUSH:
+			hash ^= ZOBRIST_RANDOMS[773 + m->to % 8];
+			break;
+		case FLAG_CAPTURES:
+			hash ^= ZOBRIST_RANDOMS[(m->cPiece - 2) * 64 + m->to];
+			break;
+		case FLAG_EP_CAPTURE:
+			hash ^= ZOBRIST_RANDOMS[(m->cPiece - 2) * 64 + p->flag.enPassantFlag];
+			break;
+		case FLAG_KING_CASTLE:
+			hash ^= ZOBRIST_RANDOMS[(rook - 2) * 64 + m->to + 1] ^ ZOBRIST_RANDOMS[(rook - 2) * 64 + m->from + 1];
+			break;
+		case FLAG_QUEEN_CASTLE:
+			hash ^= ZOBRIST_RANDOMS[(rook - 2) * 64 + m->to - 2] ^ ZOBRIST_RANDOMS[(rook - 2) * 64 + m->from - 1];
+			break;
+		case FLAG_KNIGHT_PROMO_CAPT:
+		case FLAG_BISHOP_PROMO_CAPT:
+		case FLAG_ROOK_PROMO_CAPT:
+		case FLAG_QUEEN_PROMO_CAPT:
+			hash ^= ZOBRIST_RANDOMS[(m->cPiece - 2) * 64 + m->to];
+			break;
+	}
+	switch(m->flags) {
+		case FLAG_KNIGHT_PROMO: case FLAG_KNIGHT_PROMO_CAPT: piece = W_KNIGHT + (6 * m->colour); break;
+		case FLAG_BISHOP_PROMO: case FLAG_BISHOP_PROMO_CAPT: piece = W_BISHOP + (6 * m->colour); break;
+		case FLAG_ROOK_PROMO: case FLAG_ROOK_PROMO_CAPT: piece = W_ROOK + (6 * m->colour); break;
+		case FLAG_QUEEN_PROMO: case FLAG_QUEEN_PROMO_CAPT: piece = W_QUEEN + (6 * m->colour); break;
+	}
+	hash ^= ZOBRIST_RANDOMS[(m->piece - 2) * 64 + m->from] ^ ZOBRIST_RANDOMS[(piece - 2) * 64 + m->to];
+
+	// Rights lost by moving from or to a king or rook square
+	lost |= (fromToBB & W_KSIDE_CASTLE_SQUARES) ? W_KSIDE_CASTLE : 0;
+	lost |= (fromToBB & W_QSIDE_CASTLE_SQUARES) ? W_QSIDE_CASTLE : 0;
+	lost |= (fromToBB & B_KSIDE_CASTLE_SQUARES) ? B_KSIDE_CASTLE : 0;
+	lost |= (fromToBB & B_QSIDE_CASTLE_SQUARES) ? B_QSIDE_CASTLE : 0;
+	lost &= p->flag.castlingFlags;
+	hash ^= ZOBRIST_RANDOMS[769] * (lost & 1);
+	hash ^= ZOBRIST_RANDOMS[770] * ((lost >> 1) & 1);
+	hash ^= ZOBRIST_RANDOMS[771] * ((lost >> 2) & 1);
+	hash ^= ZOBRIST_RANDOMS[772] * ((lost >> 3) & 1);
+	return hash;
+}
+
+void makeMove(Position* p, Move* m, IrrFlagStack* fs) {
+	int oldCastlingFlags = p->flag.castlingFlags;
+	if(p->evaluator->nnueEnabled) {
+		pushNnueMove(&p->evaluator->nnueStack, &p->evaluator->nnueNetwork, p, m);
+	}
+	pushIrrFlagStack(fs, p);
+	p->player = !p->player;
+	updateZobristSideToMove(p);
+	updateZobristEnPassantFlag(p, p->flag.enPassantFlag);
+	uint64_t fromBB = SQUARE_BBS[m->from];
+	uint64_t toBB = SQUARE_BBS[m->to];
+	uint64_t fromToBB = fromBB ^ toBB;
+	uint64_t specialBB;
+
+	switch(m->flags) {
+		case FLAG_QUIET_MOVE:
+			p->pieceBB[m->piece] 		^= fromToBB;
+			p->pieceBB[m->colour] 	^= fromToBB;
+			p->occupiedBB 					^= fromToBB;
+			p->emptyBB							^= fromToBB;
+			p->flag.plyCount++; // Reversible move
+			p->flag.enPassantFlag = 0;
+			p->squareValueTotal += PIECE_SQUARE_VALUES[m->piece][m->to] - PIECE_SQUARE_VALUES[m->piece][m->from];
+			p->squareAttacksBB[m->from] = 0;
+			p->squareAttacksBB[m->to] = pieceAttacks(p, m->piece, m->to);
+
+			updateZobristPieceMove(p, m->piece, m->from);
+			updateZobristPieceMove(p, m->piece, m->to);
+			break;
+		case FLAG_PAWN_PUSH:
+			p->pieceBB[m->piece] 		^= fromToBB;
+			p->pieceBB[m->colour] 	^= fromToBB;
+			p->occupiedBB 					^= fromToBB;
+			p->emptyBB							^= fromToBB;
+			p->flag.plyCount = 0;
+			p->flag.enPassantFlag = 0;
+			p->squareValueTotal += PIECE_SQUARE_VALUES[m->piece][m->to] - PIECE_SQUARE_VALUES[m->piece][m->from];
+			p->squareAttacksBB[m->from] = 0;
+			p->squareAttacksBB[m->to] = pieceAttacks(p, m->piece, m->to);
+
+			updateZobristPieceMove(p, m->piece, m->from);
+			updateZobristPieceMove(p, m->piece, m->to);
+			break;
+		case FLAG_DOUBLE_PAWN_PUSH:
+			p->pieceBB[m->piece] 		^= fromToBB;
+			p->pieceBB[m->colour] 	^= fromToBB;
+			p->occupiedBB 					^= fromToBB;
+			p->emptyBB							^= fromToBB;
+			p->squareAttacksBB[m->from] = 0;
+			p->squareAttacksBB[m->to] = pieceAttacks(p, m->piece, m->to);
+			// En passant flag
+			p->flag.enPassantFlag = m->to;
+			p->flag.plyCount = 0;
+			p->squareValueTotal += PIECE_SQUARE_VALUES[m->piece][m->to] - PIECE_SQUARE_VALUES[m->piece][m->from];
+
+			updateZobristPieceMove(p, m->piece, m->from);
+			updateZobristPieceMove(p, m->piece, m->to);
+			break;
+		case FLAG_CAPTURES:
+			p->pieceBB[m->piece] 		^= fromToBB;
+			p->pieceBB[m->colour] 	^= fromToBB;
+			p->pieceBB[m->cPiece] 	^= toBB;
+			p->pieceBB[m->cColour] 	^= toBB;
+			p->occupiedBB 					^= fromBB;
+			p->emptyBB							^= fromBB;
+			p->squareAttacksBB[m->from] = 0;
+			p->squareAttacksBB[m->to] = pieceAttacks(p, m->piece, m->to);
+			p->flag.plyCount = 0;
+			p->flag.enPassantFlag = 0;
+			p->squareValueTotal += PIECE_SQUARE_VALUES[m->piece][m->to] - PIECE_SQUARE_VALUES[m->piece][m->from];
+			p->squareValueTotal -= PIECE_SQUARE_VALUES[m->cPiece][m->to];
+			p->materialCount -= PIECE_VALUES[m->cPiece];
+			p->phase -= PHASE_VALUES[m->cPiece];
+
+			updateZobristPieceMove(p, m->cPiece, m->to);
+			updateZobristPieceMove(p, m->piece, m->from);
+			updateZobristPieceMove(p, m->piece, m->to);
+			break;
+		case FLAG_EP_CAPTURE:
+			// printf("%d\n", p->flag.enPassantFlag);
+			specialBB = (SQUARE_BBS[p->flag.enPassantFlag]);
+
+			p->pieceBB[m->piece] 		^= fromToBB;
+			p->pieceBB[m->colour] 	^= fromToBB;
+			p->pieceBB[m->cPiece] 	^= specialBB;
+			p->pieceBB[m->cColour] 	^= specialBB;
+			p->occupiedBB 					^= (fromToBB | specialBB);
+			p->emptyBB							^= (fromToBB | specialBB);
+			p->squareValueTotal += PIECE_SQUARE_VALUES[m->piece][m->to] - PIECE_SQUARE_VALUES[m->piece][m->from];
+			p->squareValueTotal -= PIECE_SQUARE_VALUES[m->cPiece][p->flag.enPassantFlag];
+			p->materialCount -= PIECE_VALUES[m->cPiece];
+			// outputBitBoard(p->pieceBB[B_PAWN]);
+
+			p->squareAttacksBB[m->from] = 0;
+			p->squareAttacksBB[p->flag.enPassantFlag] = 0;
+			p->squareAttacksBB[m->to] = pieceAttacks(p, m->piece, m->to);
+			p->flag.plyCount = 0;
+
+			updateZobristPieceMove(p, m->piece, m->from);
+			updateZobristPieceMove(p, m->cPiece, p->flag.enPassantFlag);
+			updateZobristPieceMove(p, m->piece, m->to);
+
+			p->flag.enPassantFlag = 0;
+
+			break;
+		case FLAG_KING_CASTLE:
+			specialBB = (toBB>>1) | (toBB<<1); // F1/8 | H1/8
+			p->pieceBB[m->piece] 	^= fromToBB; 	// Move king
+			p->pieceBB[W_ROOK+(6*m->colour)] ^= specialBB;// Move rook
+			p->pieceBB[m->colour] ^= (fromToBB | specialBB);
+			p->occupiedBB ^= (fromToBB | specialBB);
+			p->emptyBB		^= (fromToBB | specialBB);
+			p->flag.castlingFlags &= ~((W_KSIDE_CASTLE|W_QSIDE_CASTLE)<<(2*m->colour));
+			p->squareAttacksBB[m->from] = 0; // E1/8
+			p->squareAttacksBB[m->from+1] = pieceAttacks(p, W_ROOK+(6*m->colour), m->from+1); // F1/F8
+			p->squareAttacksBB[m->to] = pieceAttacks(p, m->piece, m->to); // G1/G8
+			p->squareAttacksBB[m->to+1] = 0; // H1/H8
+			p->flag.plyCount++;
+			p->flag.enPassantFlag = 0;
+			p->squareValueTotal += PIECE_SQUARE_VALUES[m->piece][m->to] - PIECE_SQUARE_VALUES[m->piece][m->from];
+			p->squareValueTotal += PIECE_SQUARE_VALUES[W_ROOK+(6*m->colour)][m->from+1] - PIECE_SQUARE_VALUES[W_ROOK+(6*m->colour)][m->to+1];
+
+			updateZobristPieceMove(p, m->piece, m->from);
+			updateZobristPieceMove(p, m->piece, m->to);
+			updateZobristPieceMove(p, W_ROOK+(6*m->colour), m->to+1);
+			updateZobristPieceMove(p, W_ROOK+(6*m->colour), m->from+1);
+			break;
+		case FLAG_QUEEN_CASTLE:
+			specialBB = (toBB<<1) | (toBB>>2); // D1/8 | A1/8
+			p->pieceBB[m->piece] 	^= fromToBB;
+			p->pieceBB[W_ROOK+(6*m->colour)] ^= specialBB;
+			p->pieceBB[m->colour] ^= (fromToBB | specialBB);
+			p->occupiedBB ^= (fromToBB | specialBB);
+			p->emptyBB		^= (fromToBB | specialBB);
+			p->flag.castlingFlags &= ~((W_KSIDE_CASTLE|W_QSIDE_CASTLE)<<(2*m->colour));
+			p->squareAttacksBB[m->from] = 0; // E1/8
+			p->squareAttacksBB[m->from-1] = pieceAttacks(p, W_ROOK+(6*m->colour), m->from-1); // D1/D8
+			p->squareAttacksBB[m->to] = pieceAttacks(p, m->piece, m->to); // C1/C8
+			p->squareAttacksBB[m->to-2] = 0; // A1/A8
+			p->squareValueTotal += PIECE_SQUARE_VALUES[m->piece][m->to] - PIECE_SQUARE_VALUES[m->piece][m->from];
+			p->squareValueTotal += PIECE_SQUARE_VALUES[W_ROOK+(6*m->colour)][m->from-1] - PIECE_SQUARE_VALUES[W_ROOK+(6*m->colour)][m->to-2];
+			p->flag.plyCount++;
+			p->flag.enPassantFlag = 0;
+
+			updateZobristPieceMove(p, m->piece, m->from);
+			updateZobristPieceMove(p, m->piece, m->to);
+			updateZobristPieceMove(p, W_ROOK+(6*m->colour), m->to-2);
+			updateZobristPieceMove(p, W_ROOK+(6*m->colour), m->from-1);
+			break;
+		case FLAG_KNIGHT_PROMO:
+			p->pieceBB[m->piece] 	^= fromBB; // Pawn disappears
+			p->pieceBB[W_KNIGHT+(6*m->colour)] 	^= toBB;
+			p->pieceBB[m->colour] ^= fromToBB;
+			p->occupiedBB 				^= fromToBB;
+			p->emptyBB						^= fromToBB;
+			p->flag.plyCount = 0;
+			p->flag.enPassantFlag = 0;
+			p->squareValueTotal += PIECE_SQUARE_VALUES[W_KNIGHT+(6*m->colour)][m->to] - PIECE_SQUARE_VALUES[m->piece][m->from];
+			p->materialCount += PIECE_VALUES[W_KNIGHT+(6*m->colour)] - PIECE_VALUES[m->piece];
+			p->phase += PHASE_VALUES[W_KNIGHT+(6*m->colour)];
+			p->squareAttacksBB[m->from] = 0;
+			p->squareAttacksBB[m->to] = pieceAttacks(p, W_KNIGHT+(6*m->colour), m->to);
+
+			updateZobristPieceMove(p, m->piece, m->from);
+			updateZobristPieceMove(p, W_KNIGHT+(6*m->colour), m->to);
+			break;
+		case FLAG_BISHOP_PROMO:
+			p->pieceBB[m->piece] 	^= fromBB; // Pawn disappears
+			p->pieceBB[W_BISHOP+(6*m->colour)] 	^= toBB;
+			p->pieceBB[m->colour] ^= fromToBB;
+			p->occupiedBB 				^= fromToBB;
+			p->emptyBB						^= fromToBB;
+			p->squareAttacksBB[m->from] = 0;
+			p->squareAttacksBB[m->to] = pieceAttacks(p, W_BISHOP+(6*m->colour), m->to);
+			p->squareValueTotal += PIECE_SQUARE_VALUES[W_BISHOP+(6*m->colour)][m->to] - PIECE_SQUARE_VALUES[m->piece][m->from];
+			p->materialCount += PIECE_VALUES[W_BISHOP+(6*m->colour)] - PIECE_VALUES[m->piece];
+			p->phase += PHASE_VALUES[W_BISHOP+(6*m->colour)];
+			p->flag.plyCount = 0;
+			p->flag.enPassantFlag = 0;
+
+			updateZobristPieceMove(p, m->piece, m->from);
+			updateZobristPieceMove(p, W_BISHOP+(6*m->colour), m->to);
+			break;
+		case FLAG_ROOK_PROMO:
+			p->pieceBB[m->piece] 	^= fromBB; // Pawn disappears
+			p->pieceBB[W_ROOK+(6*m->colour)] 	^= toBB;
+			p->pieceBB[m->colour] ^= fromToBB;
+			p->occupiedBB 				^= fromToBB;
+			p->emptyBB						^= fromToBB;
+			p->squareAttacksBB[m->from] = 0;
+			p->squareAttacksBB[m->to] = pieceAttacks(p, W_ROOK+(6*m->colour), m->to);
+			p->squareValueTotal += PIECE_SQUARE_VALUES[W_ROOK+(6*m->colour)][m->to] - PIECE_SQUARE_VALUES[m->piece][m->from];
+			p->materialCount += PIECE_VALUES[W_ROOK+(6*m->colour)] - PIECE_VALUES[m->piece];
+			p->phase += PHASE_VALUES[W_ROOK+(6*m->colour)];
+			p->flag.plyCount = 0;
+			p->flag.enPassantFlag = 0;
+
+			updateZobristPieceMove(p, m->piece, m->from);
+			updateZobristPieceMove(p, W_ROOK+(6*m->colour), m->to);
+			break;
+		case FLAG_QUEEN_PROMO:
+			p->pieceBB[m->piece] 	^= fromBB; // Pawn disappears
+			p->pieceBB[W_QUEEN+(6*m->colour)] 	^= toBB;
+			p->pieceBB[m->colour] ^= fromToBB;
+			p->occupiedBB 				^= fromToBB;
+			p->emptyBB						^= fromToBB;
+			p->squareAttacksBB[m->from] = 0;
+			p->squareAttacksBB[m->to] = pieceAttacks(p, W_QUEEN+(6*m->colour), m->to);
+			p->squareValueTotal += PIECE_SQUARE_VALUES[W_QUEEN+(6*m->colour)][m->to] - PIECE_SQUARE_VALUES[m->piece][m->from];
+			p->materialCount += PIECE_VALUES[W_QUEEN+(6*m->colour)] - PIECE_VALUES[m->piece];
+			p->phase += PHASE_VALUES[W_QUEEN+(6*m->colour)];
+			p->flag.plyCount = 0;
+			p->flag.enPassantFlag = 0;
+
+			updateZobristPieceMove(p, m->piece, m->from);
+			updateZobristPieceMove(p, W_QUEEN+(6*m->colour), m->to);
+			break;
+		case FLAG_KNIGHT_PROMO_CAPT:
+			p->pieceBB[m->piece] 	^= fromBB; // Pawn disappears
+			p->pieceBB[W_KNIGHT+(6*m->colour)] 	^= toBB;
+			p->pieceBB[m->colour] ^= fromToBB;
+			p->pieceBB[m->cPiece] 	^= toBB;
+			p->pieceBB[m->cColour] 	^= toBB;
+			p->occupiedBB 				^= fromBB;
+			p->emptyBB						^= fromBB;
+			p->squareAttacksBB[m->from] = 0;
+			p->squareAttacksBB[m->to] = pieceAttacks(p, W_KNIGHT+(6*m->colour), m->to);
+			p->squareValueTotal += PIECE_SQUARE_VALUES[W_KNIGHT+(6*m->colour)][m->to] - PIECE_SQUARE_VALUES[m->piece][m->from];
+			p->squareValueTotal -= PIECE_SQUARE_VALUES[m->cPiece][m->to];
+			p->materialCount += PIECE_VALUES[W_KNIGHT+(6*m->colour)] - PIECE_VALUES[m->piece] - PIECE_VALUES[m->cPiece];
+			p->phase += PHASE_VALUES[W_KNIGHT+(6*m->colour)] - PHASE_VALUES[m->cPiece];
+			p->flag.plyCount = 0;
+			p->flag.enPassantFlag = 0;
+
+			updateZobristPieceMove(p, m->piece, m->from);
+			updateZobristPieceMove(p, m->cPiece, m->to);
+			updateZobristPieceMove(p, W_KNIGHT+(6*m->colour), m->to);
+			break;
+		case FLAG_BISHOP_PROMO_CAPT:
+			p->pieceBB[m->piece] 	^= fromBB; // Pawn disappears
+			p->pieceBB[W_BISHOP+(6*m->colour)] 	^= toBB;
+			p->pieceBB[m->colour] ^= fromToBB;
+			p->pieceBB[m->cPiece] 	^= toBB;
+			p->pieceBB[m->cColour] 	^= toBB;
+			p->occupiedBB 				^= fromBB;
+			p->emptyBB						^= fromBB;
+			p->squareAttacksBB[m->from] = 0;
+			p->squareAttacksBB[m->to] = pieceAttacks(p, W_BISHOP+(6*m->colour), m->to);
+			p->squareValueTotal += PIECE_SQUARE_VALUES[W_BISHOP+(6*m->colour)][m->to] - PIECE_SQUARE_VALUES[m->piece][m->from];
+			p->squareValueTotal -= PIECE_SQUARE_VALUES[m->cPiece][m->to];
+			p->materialCount += PIECE_VALUES[W_BISHOP+(6*m->colour)] - PIECE_VALUES[m->piece] - PIECE_VALUES[m->cPiece];
+			p->phase += PHASE_VALUES[W_BISHOP+(6*m->colour)] - PHASE_VALUES[m->cPiece];
+			p->flag.plyCount = 0;
+			p->flag.enPassantFlag = 0;
+
+			updateZobristPieceMove(p, m->piece, m->from);
+			updateZobristPieceMove(p, m->cPiece, m->to);
+			updateZobristPieceMove(p, W_BISHOP+(6*m->colour), m->to);
+			break;
+		case FLAG_ROOK_PROMO_CAPT:
+			p->pieceBB[m->piece] 	^= fromBB; // Pawn disappears
+			p->pieceBB[W_ROOK+(6*m->colour)] 	^= toBB;
+			p->pieceBB[m->colour] ^= fromToBB;
+			p->pieceBB[m->cPiece] 	^= toBB;
+			p->pieceBB[m->cColour] 	^= toBB;
+			p->occupiedBB 				^= fromBB;
+			p->emptyBB						^= fromBB;
+			p->squareAttacksBB[m->from] = 0;
+			p->squareAttacksBB[m->to] = pieceAttacks(p, W_ROOK+(6*m->colour), m->to);
+			p->squareValueTotal += PIECE_SQUARE_VALUES[W_ROOK+(6*m->colour)][m->to] - PIECE_SQUARE_VALUES[m->piece][m->from];
+			p->squareValueTotal -= PIECE_SQUARE_VALUES[m->cPiece][m->to];
+			p->materialCount += PIECE_VALUES[W_ROOK+(6*m->colour)] - PIECE_VALUES[m->piece] - PIECE_VALUES[m->cPiece];
+			p->phase += PHASE_VALUES[W_ROOK+(6*m->colour)] - PHASE_VALUES[m->cPiece];
+			p->flag.plyCount = 0;
+			p->flag.enPassantFlag = 0;
+
+			updateZobristPieceMove(p, m->piece, m->from);
+			updateZobristPieceMove(p, m->cPiece, m->to);
+			updateZobristPieceMove(p, W_ROOK+(6*m->colour), m->to);
+			break;
+		case FLAG_QUEEN_PROMO_CAPT:
+			p->pieceBB[m->piece] 	^= fromBB; // Pawn disappears
+			p->pieceBB[W_QUEEN+(6*m->colour)] 	^= toBB;
+			p->pieceBB[m->colour] ^= fromToBB;
+			p->pieceBB[m->cPiece] 	^= toBB;
+			p->pieceBB[m->cColour] 	^= toBB;
+			p->occupiedBB 				^= fromBB;
+			p->emptyBB						^= fromBB;
+			p->squareValueTotal += PIECE_SQUARE_VALUES[W_QUEEN+(6*m->colour)][m->to] - PIECE_SQUARE_VALUES[m->piece][m->from];
+			p->squareValueTotal -= PIECE_SQUARE_VALUES[m->cPiece][m->to];
+			p->materialCount += PIECE_VALUES[W_QUEEN+(6*m->colour)] - PIECE_VALUES[m->piece] - PIECE_VALUES[m->cPiece];
+			p->phase += PHASE_VALUES[W_QUEEN+(6*m->colour)] - PHASE_VALUES[m->cPiece];
+			p->squareAttacksBB[m->from] = 0;
+			p->squareAttacksBB[m->to] = pieceAttacks(p, W_QUEEN+(6*m->colour), m->to);
+			p->flag.plyCount = 0;
+			p->flag.enPassantFlag = 0;
+
+			updateZobristPieceMove(p, m->piece, m->from);
+			updateZobristPieceMove(p, m->cPiece, m->to);
+			updateZobristPieceMove(p, W_QUEEN+(6*m->colour), m->to);
+			break;
+	}
+	// Test. (Need to consider every combination seperately?)
+	// Bitboard consts aren't constant expressions in C, so can't be labels
+	switch(fromToBB & CASTLE_SQUARES) {
+		case 0: break;
+		case (1ULL<<A1_INT):
+			p->flag.castlingFlags &= ~W_QSIDE_CASTLE;
+			break;
+		case (1ULL<<H1_INT):
+			p->flag.castlingFlags &= ~W_KSIDE_CASTLE;
+			break;
+		case (1ULL<<A8_INT):
+			p->flag.castlingFlags &= ~B_QSIDE_CASTLE;
+			break;
+		case (1ULL<<H8_INT):
+			p->flag.castlingFlags &= ~B_KSIDE_CASTLE;
+			break;
+		case (1ULL<<E1_INT):
+			p->flag.castlingFlags &= ~(W_QSIDE_CASTLE | W_KSIDE_CASTLE);
+			break;
+		case (1ULL<<E8_INT):
+			p->flag.castlingFlags &= ~(B_QSIDE_CASTLE | B_KSIDE_CASTLE);
+			break;
+		case ((1ULL<<A1_INT) | (1ULL<<A8_INT)):
+			p->flag.castlingFlags &= ~(W_QSIDE_CASTLE | B_QSIDE_CASTLE);
+			break;
+		case ((1ULL<<H1_INT) | (1ULL<<H8_INT)):
+			p->flag.castlingFlags &= ~(W_KSIDE_CASTLE | B_KSIDE_CASTLE);
+			break;
+		case ((1ULL<<A1_INT) | (1ULL<<H8_INT)):
+			p->flag.castlingFlags &= ~(W_QSIDE_CASTLE | B_KSIDE_CASTLE);
+			break;
+		case ((1ULL<<H1_INT) | (1ULL<<A8_INT)):
+			p->flag.castlingFlags &= ~(W_KSIDE_CASTLE | B_QSIDE_CASTLE);
+			break;
+	}
+	updateZobristCastlingFlag(p, oldCastlingFlags - p->flag.castlingFlags);
+	updateZobristEnPassantFlag(p, p->flag.enPassantFlag);
+
+	// verifyHash(p, m, 4);
+}
+
+void unmakeMove(Position* p, Move* m, IrrFlagStack* fs) {
+	int oldCastlingFlags = p->flag.castlingFlags;
+	if(p->evaluator->nnueEnabled) {
+		popNnueMove(&p->evaluator->nnueStack);
+	}
+	updateZobristEnPassantFlag(p, p->flag.enPassantFlag);
+
+	p->player = !p->player;
+	p->flag = popIrrFlagStack(fs);
+
+	updateZobristCastlingFlag(p, p->flag.castlingFlags - oldCastlingFlags);
+	uint64_t fromBB = SQUARE_BBS[m->from];
+	uint64_t toBB = SQUARE_BBS[m->to];
+	uint64_t fromToBB = fromBB ^ toBB;
+	uint64_t specialBB;
+	switch(m->flags) {
+		case FLAG_QUIET_MOVE:
+		case FLAG_PAWN_PUSH:
+		case FLAG_DOUBLE_PAWN_PUSH:
+			p->pieceBB[m->piece] 	^= fromToBB;
+			p->pieceBB[m->colour] 	^= fromToBB;
+			p->occupiedBB 					^= fromToBB;
+			p->emptyBB							^= fromToBB;
+			p->squareAttacksBB[m->to] = 0;
+			p->squareAttacksBB[m->from] = pieceAttacks(p, m->piece, m->from);
+			p->squareValueTotal -= PIECE_SQUARE_VALUES[m->piece][m->to] - PIECE_SQUARE_VALUES[m->piece][m->from];
+
+			updateZobristPieceMove(p, m->piece, m->to);
+			updateZobristPieceMove(p, m->piece, m->from);
+			break;
+		case FLAG_CAPTURES:
+			p->pieceBB[m->piece] 	^= fromToBB;
+			p->pieceBB[m->colour] 	^= fromToBB;
+			p->pieceBB[m->cPiece] 	^= toBB;
+			p->pieceBB[m->cColour] 	^= toBB;
+			p->occupiedBB 					^= fromBB;
+			p->emptyBB							^= fromBB;
+			p->squareValueTotal -= PIECE_SQUARE_VALUES[m->piece][m->to] - PIECE_SQUARE_VALUES[m->piece][m->from];
+			p->squareValueTotal += PIECE_SQUARE_VALUES[m->cPiece][m->to];
+			p->materialCount += PIECE_VALUES[m->cPiece];
+			p->phase += PHASE_VALUES[m->cPiece];
+			p->squareAttacksBB[m->to] = pieceAttacks(p, m->cPiece, m->to);
+			p->squareAttacksBB[m->from] = pieceAttacks(p, m->piece, m->from);
+
+			updateZobristPieceMove(p, m->piece, m->to);
+			updateZobristPieceMove(p, m->cPiece, m->to);
+			updateZobristPieceMove(p, m->piece, m->from);
+			break;
+		case FLAG_EP_CAPTURE:
+			specialBB = (SQUARE_BBS[p->flag.enPassantFlag]);
+			p->pieceBB[m->piece] 		^= fromToBB;
+			p->pieceBB[m->colour] 	^= fromToBB;
+			p->pieceBB[m->cPiece] 	^= specialBB;
+			p->pieceBB[m->cColour] 	^= specialBB;
+			p->occupiedBB 					^= (fromToBB | specialBB);
+			p->emptyBB							^= (fromToBB | specialBB);
+			p->squareValueTotal -= PIECE_SQUARE_VALUES[m->piece][m->to] - PIECE_SQUARE_VALUES[m->piece][m->from];
+			p->squareValueTotal += PIECE_SQUARE_VALUES[m->cPiece][p->flag.enPassantFlag];
+			p->materialCount += PIECE_VALUES[m->cPiece];
+			p->squareAttacksBB[m->to] = 0;
+			p->squareAttacksBB[m->from] = pieceAttacks(p, m->piece, m->from);
+			p->squareAttacksBB[p->flag.enPassantFlag] = pieceAttacks(p, m->cPiece, p->flag.enPassantFlag);
+
+			updateZobristPieceMove(p, m->piece, m->to);
+			updateZobristPieceMove(p, m->cPiece, p->flag.enPassantFlag);
+			updateZobristPieceMove(p, m->piece, m->from);
+			break;
+		case FLAG_KING_CASTLE:
+			specialBB = (toBB>>1) | (toBB<<1); // F1/8 | H1/8
+			p->pieceBB[m->piece] 	^= fromToBB; 	// Move king
+			p->pieceBB[W_ROOK+(6*m->colour)] ^= specialBB;// Move rook
+			p->pieceBB[m->colour] ^= (fromToBB | specialBB);
+			p->occupiedBB ^= (fromToBB | specialBB);
+			p->emptyBB		^= (fromToBB | specialBB);
+
+			p->squareAttacksBB[m->from] = pieceAttacks(p, m->piece, m->from);; // E1/8
+			p->squareAttacksBB[m->from+1] = 0;// F1/F8
+			p->squareAttacksBB[m->to] = 0; // G1/G8
+			p->squareAttacksBB[m->to+1] = pieceAttacks(p, W_ROOK+(6*m->colour), m->to+1);  // H1/H8
+
+			p->squareValueTotal -= PIECE_SQUARE_VALUES[m->piece][m->to] - PIECE_SQUARE_VALUES[m->piece][m->from];
+			p->squareValueTotal -= PIECE_SQUARE_VALUES[W_ROOK+(6*m->colour)][m->from+1] - PIECE_SQUARE_VALUES[W_ROOK+(6*m->colour)][m->to+1];
+
+			updateZobristPieceMove(p, m->piece, m->to);
+			updateZobristPieceMove(p, m->piece, m->from);
+			updateZobristPieceMove(p, W_ROOK+(6*m->colour), m->from+1);
+			updateZobristPieceMove(p, W_ROOK+(6*m->colour), m->to+1);
+			break;
+		case FLAG_QUEEN_CASTLE:
+			specialBB = (toBB<<1) | (toBB>>2); // D1/8 | A1/8
+			p->pieceBB[m->piece] 	^= fromToBB;
+			p->pieceBB[W_ROOK+(6*m->colour)] ^= specialBB;
+			p->pieceBB[m->colour] ^= (fromToBB | specialBB);
+			p->occupiedBB ^= (fromToBB | specialBB);
+			p->emptyBB		^= (fromToBB | specialBB);
+
+			p->squareAttacksBB[m->from] = pieceAttacks(p, m->piece, m->from); // C1/C8; // E1/8
+			p->squareAttacksBB[m->from-1] = 0; // D1/D8
+			p->squareAttacksBB[m->to] = 0;
+			p->squareAttacksBB[m->to-2] = pieceAttacks(p, W_ROOK+(6*m->colour), m->to-2); // A1/A8
+
+			p->squareValueTotal -= PIECE_SQUARE_VALUES[m->piece][m->to] - PIECE_SQUARE_VALUES[m->piece][m->from];
+			p->squareValueTotal -= PIECE_SQUARE_VALUES[W_ROOK+(6*m->colour)][m->from-1] - PIECE_SQUARE_VALUES[W_ROOK+(6*m->colour)][m->to-2];
+
+			updateZobristPieceMove(p, m->piece, m->to);
+			updateZobristPieceMove(p, m->piece, m->from);
+			updateZobristPieceMove(p, W_ROOK+(6*m->colour), m->from-1);
+			updateZobristPieceMove(p, W_ROOK+(6*m->colour), m->to-2);
+			break;
+		case FLAG_KNIGHT_PROMO:
+			p->pieceBB[m->piece] 	^= fromBB; // Pawn appears
+			p->pieceBB[W_KNIGHT+(6*m->colour)] 	^= toBB;
+			p->pieceBB[m->colour] ^= fromToBB;
+			p->occupiedBB 				^= fromToBB;
+			p->emptyBB						^= fromToBB;
+
+			p->squareAttacksBB[m->to] = 0;
+			p->squareAttacksBB[m->from] = pieceAttacks(p, m->piece, m->from);
+
+			p->squareValueTotal -= PIECE_SQUARE_VALUES[W_KNIGHT+(6*m->colour)][m->to] - PIECE_SQUARE_VALUES[m->piece][m->from];
+			p->materialCount -= PIECE_VALUES[W_KNIGHT+(6*m->colour)] - PIECE_VALUES[m->piece];
+			p->phase -= PHASE_VALUES[W_KNIGHT+(6*m->colour)];
+
+			updateZobristPieceMove(p, W_KNIGHT+(6*m->colour), m->to);
+			updateZobristPieceMove(p, m->piece, m->from);
+			break;
+		case FLAG_BISHOP_PROMO:
+			p->pieceBB[m->piece] 	^= fromBB;
+			p->pieceBB[W_BISHOP+(6*m->colour)] 	^= toBB;
+			p->pieceBB[m->colour] ^= fromToBB;
+			p->occupiedBB 				^= fromToBB;
+			p->emptyBB						^= fromToBB;
+
+			p->squareAttacksBB[m->to] = 0;
+			p->squareAttacksBB[m->from] = pieceAttacks(p, m->piece, m->from);
+
+			p->squareValueTotal -= PIECE_SQUARE_VALUES[W_BISHOP+(6*m->colour)][m->to] - PIECE_SQUARE_VALUES[m->piece][m->from];
+			p->materialCount -= PIECE_VALUES[W_BISHOP+(6*m->colour)] - PIECE_VALUES[m->piece];
+			p->phase -= PHASE_VALUES[W_BISHOP+(6*m->colour)];
+
+			updateZobristPieceMove(p, W_BISHOP+(6*m->colour), m->to);
+			updateZobristPieceMove(p, m->piece, m->from);
+			break;
+		case FLAG_ROOK_PROMO:
+			p->pieceBB[m->piece] 	^= fromBB;
+			p->pieceBB[W_ROOK+(6*m->colour)] 	^= toBB;
+			p->pieceBB[m->colour] ^= fromToBB;
+			p->occupiedBB 				^= fromToBB;
+			p->emptyBB						^= fromToBB;
+
+			p->squareAttacksBB[m->to] = 0;
+			p->squareAttacksBB[m->from] = pieceAttacks(p, m->piece, m->from);
+
+			p->squareValueTotal -= PIECE_SQUARE_VALUES[W_ROOK+(6*m->colour)][m->to] - PIECE_SQUARE_VALUES[m->piece][m->from];
+			p->materialCount -= PIECE_VALUES[W_ROOK+(6*m->colour)] - PIECE_VALUES[m->piece];
+			p->phase -= PHASE_VALUES[W_ROOK+(6*m->colour)];
+
+			updateZobristPieceMove(p, W_ROOK+(6*m->colour), m->to);
+			updateZobristPieceMove(p, m->piece, m->from);
+			break;
+		case FLAG_QUEEN_PROMO:
+			p->pieceBB[m->piece] 	^= fromBB;
+			p->pieceBB[W_QUEEN+(6*m->colour)] 	^= toBB;
+			p->pieceBB[m->colour] ^= fromToBB;
+			p->occupiedBB 				^= fromToBB;
+			p->emptyBB						^= fromToBB;
+
+			p->squareAttacksBB[m->to] = 0;
+			p->squareAttacksBB[m->from] = pieceAttacks(p, m->piece, m->from);
+
+			p->squareValueTotal -= PIECE_SQUARE_VALUES[W_QUEEN+(6*m->colour)][m->to] - PIECE_SQUARE_VALUES[m->piece][m->from];
+			p->materialCount -= PIECE_VALUES[W_QUEEN+(6*m->colour)] - PIECE_VALUES[m->piece];
+			p->phase -= PHASE_VALUES[W_QUEEN+(6*m->colour)];
+
+			updateZobristPieceMove(p, W_QUEEN+(6*m->colour), m->to);
+			updateZobristPieceMove(p, m->piece, m->from);
+			break;
+		case FLAG_KNIGHT_PROMO_CAPT:
+			p->pieceBB[m->piece] 	^= fromBB;
+			p->pieceBB[W_KNIGHT+(6*m->colour)] 	^= toBB;
+			p->pieceBB[m->colour] ^= fromToBB;
+			p->pieceBB[m->cPiece] 	^= toBB;
+			p->pieceBB[m->cColour] 	^= toBB;
+			p->occupiedBB 				^= fromBB;
+			p->emptyBB						^= fromBB;
+
+			p->squareAttacksBB[m->from] = pieceAttacks(p, m->piece, m->from);
+			p->squareAttacksBB[m->to] = pieceAttacks(p, m->cPiece, m->to);
+
+			p->squareValueTotal -= PIECE_SQUARE_VALUES[W_KNIGHT+(6*m->colour)][m->to] - PIECE_SQUARE_VALUES[m->piece][m->from];
+			p->squareValueTotal += PIECE_SQUARE_VALUES[m->cPiece][m->to];
+			p->materialCount -= PIECE_VALUES[W_KNIGHT+(6*m->colour)] - PIECE_VALUES[m->piece] - PIECE_VALUES[m->cPiece];
+			p->phase -= PHASE_VALUES[W_KNIGHT+(6*m->colour)] - PHASE_VALUES[m->cPiece];
+
+			updateZobristPieceMove(p, W_KNIGHT+(6*m->colour), m->to);
+			updateZobristPieceMove(p, m->cPiece, m->to);
+			updateZobristPieceMove(p, m->piece, m->from);
+			break;
+		case FLAG_BISHOP_PROMO_CAPT:
+			p->pieceBB[m->piece] 	^= fromBB;
+			p->pieceBB[W_BISHOP+(6*m->colour)] 	^= toBB;
+			p->pieceBB[m->colour] ^= fromToBB;
+			p->pieceBB[m->cPiece] 	^= toBB;
+			p->pieceBB[m->cColour] 	^= toBB;
+			p->occupiedBB 				^= fromBB;
+			p->emptyBB						^= fromBB;
+
+			p->squareAttacksBB[m->from] = pieceAttacks(p, m->piece, m->from);
+			p->squareAttacksBB[m->to] = pieceAttacks(p, m->cPiece, m->to);
+
+			p->squareValueTotal -= PIECE_SQUARE_VALUES[W_BISHOP+(6*m->colour)][m->to] - PIECE_SQUARE_VALUES[m->piece][m->from];
+			p->squareValueTotal += PIECE_SQUARE_VALUES[m->cPiece][m->to];
+			p->materialCount -= PIECE_VALUES[W_BISHOP+(6*m->colour)] - PIECE_VALUES[m->piece] - PIECE_VALUES[m->cPiece];
+			p->phase -= PHASE_VALUES[W_BISHOP+(6*m->colour)] - PHASE_VALUES[m->cPiece];
+
+			updateZobristPieceMove(p, W_BISHOP+(6*m->colour), m->to);
+			updateZobristPieceMove(p, m->cPiece, m->to);
+			updateZobristPieceMove(p, m->piece, m->from);
+			break;
+		case FLAG_ROOK_PROMO_CAPT:
+			p->pieceBB[m->piece] 	^= fromBB;
+			p->pieceBB[W_ROOK+(6*m->colour)] 	^= toBB;
+			p->pieceBB[m->colour] ^= fromToBB;
+			p->pieceBB[m->cPiece] 	^= toBB;
+			p->pieceBB[m->cColour] 	^= toBB;
+			p->occupiedBB 				^= fromBB;
+			p->emptyBB						^= fromBB;
+
+			p->squareAttacksBB[m->from] = pieceAttacks(p, m->piece, m->from);
+			p->squareAttacksBB[m->to] = pieceAttacks(p, m->cPiece, m->to);
+
+			p->squareValueTotal -= PIECE_SQUARE_VALUES[W_ROOK+(6*m->colour)][m->to] - PIECE_SQUARE_VALUES[m->piece][m->from];
+			p->squareValueTotal += PIECE_SQUARE_VALUES[m->cPiece][m->to];
+			p->materialCount -= PIECE_VALUES[W_ROOK+(6*m->colour)] - PIECE_VALUES[m->piece] - PIECE_VALUES[m->cPiece];
+			p->phase -= PHASE_VALUES[W_ROOK+(6*m->colour)] - PHASE_VALUES[m->cPiece];
+
+			updateZobristPieceMove(p, W_ROOK+(6*m->colour), m->to);
+			updateZobristPieceMove(p, m->cPiece, m->to);
+			updateZobristPieceMove(p, m->piece, m->from);
+			break;
+		case FLAG_QUEEN_PROMO_CAPT:
+			p->pieceBB[m->piece] 	^= fromBB;
+			p->pieceBB[W_QUEEN+(6*m->colour)] 	^= toBB;
+			p->pieceBB[m->colour] ^= fromToBB;
+			p->pieceBB[m->cPiece] 	^= toBB;
+			p->pieceBB[m->cColour] 	^= toBB;
+			p->occupiedBB 				^= fromBB;
+			p->emptyBB						^= fromBB;
+
+			p->squareAttacksBB[m->from] = pieceAttacks(p, m->piece, m->from);
+			p->squareAttacksBB[m->to] = pieceAttacks(p, m->cPiece, m->to);
+
+			p->squareValueTotal -= PIECE_SQUARE_VALUES[W_QUEEN+(6*m->colour)][m->to] - PIECE_SQUARE_VALUES[m->piece][m->from];
+			p->squareValueTotal += PIECE_SQUARE_VALUES[m->cPiece][m->to];
+			p->materialCount -= PIECE_VALUES[W_QUEEN+(6*m->colour)] - PIECE_VALUES[m->piece] - PIECE_VALUES[m->cPiece];
+			p->phase -= PHASE_VALUES[W_QUEEN+(6*m->colour)] - PHASE_VALUES[m->cPiece];
+
+			updateZobristPieceMove(p, W_QUEEN+(6*m->colour), m->to);
+			updateZobristPieceMove(p, m->cPiece, m->to);
+			updateZobristPieceMove(p, m->piece, m->from);
+			break;
+	}
+	updateZobristEnPassantFlag(p, p->flag.enPassantFlag);
+	updateZobristSideToMove(p);
+
+	// verifyHash(p, m, 5);
+}
+
+void verifyHash(Position* p, Move* m, int code) {
+	if(p->hash != calcZobristFromScratch(p)) {
+		printf("Hash mismatch: %d %d (caller code: %d)\n", p->hash, calcZobristFromScratch(p), code);
+		// calcZobristFromScratchVerbose(p);
+		outputMove(m, TRUE);
+		outputPosition(p);
+		exit(-1);
+	}
+}
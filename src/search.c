@@ -0,0 +1,970 @@
+// Search: minimax, alpha-beta, quiescence and iterative deepening
+#include "chess-b.h"
+
+// Half width of a line's aspiration window. Each fail widens it fourfold
+// on that side, until it passes ASPIRATION_MAX and that side is opened.
+// Scores swing too much between the shallowest iterations to aim at, so
+// those have open windows
+#define ASPIRATION_WINDOW 200
+#define ASPIRATION_MAX 1000
+#define ASPIRATION_DEPTH 4
+
+__thread SearchStats SEARCH_STATS;
+__thread PvLine SEARCH_PV;
+// Set up by iterativeDeepeningAI for searchStopped
+static __thread SearchControl* SEARCH_CONTROL;
+static __thread int SEARCH_STOPPED;
+static __thread int SEARCH_POLL_COUNTDOWN;
+static __thread int SEARCH_ITERATION;
+static __thread int SEARCH_MAX_DEPTH;
+// Triangular PV table. PV_TABLE[ply] is the best line found from ply,
+// built up from the line of the ply below as the search backs up
+static __thread Move PV_TABLE[PV_MAX_PLY][PV_MAX_PLY];
+static __thread int PV_LENGTH[PV_MAX_PLY];
+
+// Whether the search has to stop, now or since it was last asked. A search
+// told to stop after infinite was cleared finishes at once if it's already
+// past its depth
+static inline int searchStopped() {
+	if(SEARCH_CONTROL != NULL && !SEARCH_STOPPED && --SEARCH_POLL_COUNTDOWN <= 0) {
+		SEARCH_POLL_COUNTDOWN = SEARCH_POLL_NODES;
+		SEARCH_STOPPED = atomic_load_explicit(&SEARCH_CONTROL->stop, memory_order_relaxed)
+			|| (SEARCH_ITERATION > SEARCH_MAX_DEPTH && !atomic_load_explicit(&SEARCH_CONTROL->infinite, memory_order_relaxed));
+	}
+	return SEARCH_STOPPED;
+}
+
+// Plies from the root of the current search
+static inline int searchPly(IrrFlagStack* fs) {
+	return fs->used - SEARCH_STATS.rootPly;
+}
+
+// Score for player being checkmated, ply plies from the root. Nearer mates
+// are further from 0, so the winner prefers the shortest and the loser the
+// longest
+static inline int matedScore(int player, int ply) {
+	return (player == WHITE) ? -(MATE_SCORE - ply) : MATE_SCORE - ply;
+}
+
+// m is the new best move at ply, so the line from ply is m then the line
+// from ply + 1
+static inline void updatePv(int ply, Move* m) {
+	int length;
+	if(ply >= PV_MAX_PLY) {
+		return;
+	}
+	length = (ply + 1 < PV_MAX_PLY) ? PV_LENGTH[ply + 1] : 0;
+	PV_TABLE[ply][0] = *m;
+	memcpy(&PV_TABLE[ply][1], PV_TABLE[ply + 1], length * sizeof(Move));
+	PV_LENGTH[ply] = length + 1;
+}
+
+// Mate scores are stored in the TT relative to the node rather than the
+// root, as the same position can be reached at different plies
+static inline int scoreToTT(int score, int ply) {
+	if(score >= MATE_BOUND) {
+		return score + ply;
+	} else if(score <= -MATE_BOUND) {
+		return score - ply;
+	}
+	return score;
+}
+
+static inline int scoreFromTT(int score, int ply) {
+	if(score >= MATE_BOUND) {
+		return score - ply;
+	} else if(score <= -MATE_BOUND) {
+		return score + ply;
+	}
+	return score;
+}
+
+int dirtyAlphaBeta(Position* p, IrrFlagStack* fs, int depth, int maxExtensions, int alpha, int beta) {
+	// printf("Minimax, Depth=%d, alpha=%d, beta=%d\n", depth, alpha, beta);
+	// outputBoard(b);
+	if(depth == 0) {
+		return cachedEval(p);
+	}
+
+	MoveList ml;
+	genMoves(&ml, p);
+	int numMoves = ml.used;
+	if(numMoves == 0) {
+		freeMoveList(&ml);
+		return cachedEval(p);
+	}
+	int bestScore, eval;
+	Move m;
+	// int bestIndex = 0;
+	if(p->player == WHITE) {
+		// Maximising player
+		bestScore = INT_MIN;
+		for(int i=0; i<numMoves; i++) {
+			m = ml.list[i];
+			if(m.cPiece == B_KING) {
+				return 10000;
+			}
+			makeMove(p, &m, fs);
+			eval = dirtyAlphaBeta(p, fs, depth - 1, maxExtensions, alpha, beta);
+			unmakeMove(p, &m, fs);
+			bestScore = (bestScore > eval) ? bestScore : eval;
+			alpha = (alpha > bestScore) ? alpha : bestScore;
+			if(alpha >= beta) {
+				break;
+			}
+		}
+	} else {
+		// Minimising player
+		bestScore = INT_MAX;
+		for(int i=0; i<numMoves; i++) {
+			m = ml.list[i];
+			if(m.cPiece == W_KING) {
+				return -10000;
+			}
+			makeMove(p, &m, fs);
+			eval = dirtyAlphaBeta(p, fs, depth - 1, maxExtensions, alpha, beta);
+			unmakeMove(p, &m, fs);
+			bestScore = (bestScore < eval) ? bestScore : eval;
+			beta = (beta < bestScore) ? beta : bestScore;
+			if(beta <= alpha) {
+				break;
+			}
+		}
+	}
+	// printf("Returning: %d", bestScore);
+	freeMoveList(&ml);
+
+	return bestScore;
+}
+
+//	quickSort
+//  @author Darel Rex Finley
+void qsortMoveList(MoveList* ml, int* vals, int elements) {
+
+  int piv, L, R;
+	int beg[128], end[128];
+	int i=0;
+	Move tempMove;
+
+  beg[0]=0;
+	end[0]=elements;
+  while (i>=0) {
+    L=beg[i];
+		R=end[i]-1;
+    if (L<R) {
+      piv=vals[L];
+			tempMove =ml->list[L];
+			if (i==127) return;
+      while (L<R) {
+        while (vals[R]>=piv && L<R)
+					R--;
+				if (L<R) {
+					ml->list[L]=ml->list[R];
+					vals[L++]=vals[R];
+				}
+        while (vals[L]<=piv && L<R)
+					L++;
+				if (L<R) {
+					ml->list[R]=ml->list[L];
+					vals[R--]=vals[L];
+				}
+			}
+			ml->list[L]=tempMove;
+      vals[L]=piv;
+			beg[i+1]=L+1;
+			end[i+1]=end[i];
+			end[i++]=L;
+		}
+    else {
+      i--;
+		}
+	}
+}
+
+// Most value victim + least valuable attacker
+void sortCapturesMVVLVA(MoveList* ml) {
+	int length = ml->used;
+	int values[length];
+	int i;
+	for(i=0; i<length; i++) {
+		values[i] = PIECE_VALUES_ABS[ml->list[i].piece] - PIECE_VALUES_ABS[ml->list[i].cPiece];
+	}
+	qsortMoveList(ml, values, length);
+}
+
+// Most value victim
+void sortCapturesMVV(MoveList* ml) {
+	int length = ml->used;
+	int values[length];
+	int i;
+	for(i=0; i<length; i++) {
+		values[i] = -PIECE_VALUES_ABS[ml->list[i].cPiece];
+	}
+	qsortMoveList(ml, values, length);
+}
+
+int quiescenceSearch(Position* p, IrrFlagStack* fs, int maxExtensions, int alpha, int beta) {
+	// printf("quiescenceSearch, Depth=%d, alpha=%d, beta=%d\n", maxExtensions, alpha, beta);
+	// TODO
+	if(maxExtensions == 0) {
+		return cachedEval(p);
+	}
+
+	int standPat = cachedEval(p);
+	if(standPat >= beta) {
+		return standPat;
+	}
+	if(alpha < standPat) {
+		alpha = standPat;
+	}
+
+	MoveList ml;
+	genCaptures(&ml, p, fs);
+	// outputPosition(p);
+	// outputMoveList(&ml, '\n', TRUE);
+	sortCapturesMVVLVA(&ml);
+	// outputMoveList(&ml, '\n', TRUE);
+	int numMoves = ml.used;
+	if(numMoves == 0) {
+		freeMoveList(&ml);
+		// return heuristicEval(p);
+		return standPat;
+	}
+	int bestScore, eval;
+	Move* m;
+	// int bestIndex = 0;
+	if(p->player == WHITE) {
+		// Maximising player
+		bestScore = INT_MIN;
+		for(int i=0; i<numMoves; i++) {
+			m = &ml.list[i];
+			makeMove(p, m, fs);
+			eval = quiescenceSearch(p, fs, maxExtensions - 1, alpha, beta);
+			unmakeMove(p, m, fs);
+			bestScore = (bestScore > eval) ? bestScore : eval;
+			alpha = (alpha > bestScore) ? alpha : bestScore;
+			if(alpha >= beta) {
+				break;
+			}
+		}
+	} else {
+		// Minimising player
+		bestScore = INT_MAX;
+		for(int i=0; i<numMoves; i++) {
+			m =  &ml.list[i];
+			makeMove(p, m, fs);
+			// verifyHash(p, m, 2);
+			eval = quiescenceSearch(p, fs, maxExtensions - 1, alpha, beta);
+			unmakeMove(p, m, fs);
+			// verifyHash(p, m, 3);
+			bestScore = (bestScore < eval) ? bestScore : eval;
+			beta = (beta < bestScore) ? beta : bestScore;
+			if(beta <= alpha) {
+				break;
+			}
+		}
+	}
+	// printf("Returning: %d", bestScore);
+	freeMoveList(&ml);
+
+	return bestScore;
+}
+
+int alphaBeta(Position* p, IrrFlagStack* fs, int depth, int maxExtensions, int alpha, int beta, int capture) {
+	// printf("Minimax, Depth=%d, alpha=%d, beta=%d\n", depth, alpha, beta);
+	// outputBoard(b);
+	if(depth == 0) {
+		switch(capture) {
+			case 0:
+				return cachedEval(p);
+			default:
+				return quiescenceSearch(p, fs, maxExtensions, alpha, beta);
+		}
+	}
+
+	MoveList ml;
+	genLegalMoves(&ml, p, fs);
+	sortCapturesMVV(&ml);
+	int numMoves = ml.used;
+	if(numMoves == 0) {
+		freeMoveList(&ml);
+		switch(scoreFinalPosition(p)) {
+			case RES_WHITE_WIN:
+				return matedScore(BLACK, searchPly(fs));
+			case RES_BLACK_WIN:
+				return matedScore(WHITE, searchPly(fs));
+			default:
+				return 0;
+		}
+	}
+	int bestScore, eval;
+	Move* m;
+	// int bestIndex = 0;
+	if(p->player == WHITE) {
+		// Maximising player
+		bestScore = INT_MIN;
+		for(int i=0; i<numMoves; i++) {
+			m = &ml.list[i];
+			makeMove(p, m, fs);
+			// verifyHash(p, m, 0);
+			eval = alphaBeta(p, fs, depth - 1, maxExtensions, alpha, beta, m->cPiece);
+			unmakeMove(p, m, fs);
+			// verifyHash(p, m, 1);
+			bestScore = (bestScore > eval) ? bestScore : eval;
+			alpha = (alpha > bestScore) ? alpha : bestScore;
+			if(alpha >= beta) {
+				break;
+			}
+		}
+	} else {
+		// Minimising player
+		bestScore = INT_MAX;
+		for(int i=0; i<numMoves; i++) {
+			m =  &ml.list[i];
+			makeMove(p, m, fs);
+			eval = alphaBeta(p, fs, depth - 1, maxExtensions, alpha, beta, m->cPiece);
+			unmakeMove(p, m, fs);
+			bestScore = (bestScore < eval) ? bestScore : eval;
+			beta = (beta < bestScore) ? beta : bestScore;
+			if(beta <= alpha) {
+				break;
+			}
+		}
+	}
+	// printf("Returning: %d", bestScore);
+	freeMoveList(&ml);
+
+	return bestScore;
+}
+
+Move ai(Position* p, IrrFlagStack* fs, int depth, int aiMode, int maxExtensions, int verbose) {
+	MoveList ml;
+	Move returnMove;
+	refreshEvaluator(p->evaluator, p);
+	SEARCH_STATS.rootPly = fs->used;
+	genLegalMoves(&ml, p, fs);
+	int numMoves = ml.used;
+	if(numMoves == 0) {
+		printf("Error: No legal moves.\n");
+		freeMoveList(&ml);
+		return returnMove;
+	}
+	int scores[numMoves];
+	int bestScore, alpha, beta;
+	int bestIndex = 0;
+	Move *m;
+	alpha = INT_MIN;
+	beta = INT_MAX;
+	if(p->player == WHITE) {
+		// Maximising player
+		bestScore = INT_MIN;
+		for(int i=0; i<numMoves; i++) {
+			m = &ml.list[i];
+			makeMove(p, m, fs);
+			// scores[i] = fastEvaluateMove(b, &ml.list[i], depth);
+			switch(aiMode) {
+				case DIRTY_AI:
+					scores[i] = dirtyAlphaBeta(p, fs, depth, maxExtensions, alpha, beta);
+				case NORMAL_AI:
+				default:
+					scores[i] = alphaBeta(p, fs, depth, maxExtensions, alpha, beta, m->cPiece);
+			}
+			unmakeMove(p, m, fs);
+			if(verbose == TRUE) {
+				// printf("\nFinal score for move: ");
+				printf("(");
+				outputMove(m, FALSE);
+				printf(": %d) ", scores[i]);
+			}
+			if(scores[i] > bestScore) {
+				bestScore = scores[i];
+				bestIndex = i;
+			}
+			alpha = (alpha > bestScore) ? alpha : bestScore;
+		}
+	} else {
+		// Minimising player
+		bestScore = INT_MAX;
+		for(int i=0; i<numMoves; i++) {
+			m = &ml.list[i];
+			makeMove(p, m, fs);
+			// scores[i] = fastEvaluateMove(b, &ml.list[i], depth);
+			switch(aiMode) {
+				case DIRTY_AI:
+					scores[i] = dirtyAlphaBeta(p, fs, depth, maxExtensions, alpha, beta);
+				case NORMAL_AI:
+				default:
+					scores[i] = alphaBeta(p, fs, depth, maxExtensions, alpha, beta, m->cPiece);
+			}
+			unmakeMove(p, m, fs);
+			if(verbose == TRUE) {
+				printf("(");
+				outputMove(m, FALSE);
+				printf(": %d) ", scores[i]);
+			}
+			if(scores[i] < bestScore) {
+				bestScore = scores[i];
+				bestIndex = i;
+			}
+			beta = (beta < bestScore) ? beta : bestScore;
+		}
+	}
+	returnMove = ml.list[bestIndex];
+	if(verbose == TRUE) {
+		printf("Best move: ");
+		outputMove(&returnMove, FALSE);
+		printf(" (%d)\n", bestScore);
+	}
+	freeMoveList(&ml);
+	return returnMove;
+}
+
+void resetSearchStats(SearchStats* s) {
+	memset(s, 0, sizeof(SearchStats));
+}
+
+void addSearchStats(SearchStats* total, SearchStats* s) {
+	total->nodes += s->nodes;
+	total->qnodes += s->qnodes;
+	total->ttProbes += s->ttProbes;
+	total->ttHits += s->ttHits;
+	total->ttStores += s->ttStores;
+	total->ttOverwrites += s->ttOverwrites;
+	total->betaCutoffs += s->betaCutoffs;
+	total->firstMoveCutoffs += s->firstMoveCutoffs;
+	total->seldepth = (total->seldepth > s->seldepth) ? total->seldepth : s->seldepth;
+}
+
+// One UCI style info line. score is from the side to move's point of view.
+// multiPV is the line's number, or 0 when there's only one
+void outputSearchInfo(int depth, int multiPV, int score, uint64_t nodes, uint64_t ms, PvLine* pv) {
+	char uci[6];
+	int i;
+	// A search thread's lines mustn't be split by the main thread's output
+	flockfile(stdout);
+	printf("info depth %d ", depth);
+	if(multiPV > 0) {
+		printf("multipv %d ", multiPV);
+	}
+	printf("score ");
+	if(score >= MATE_BOUND) {
+		printf("mate %d", (MATE_SCORE - score + 1) / 2);
+	} else if(score <= -MATE_BOUND) {
+		printf("mate -%d", (MATE_SCORE + score) / 2);
+	} else {
+		printf("cp %d", score);
+	}
+	printf(" nodes %" PRIu64 " nps %" PRIu64 " time %" PRIu64 " pv", nodes, (ms > 0) ? nodes * 1000 / ms : 0, ms);
+	for(i=0; i<pv->length; i++) {
+		moveToUci(uci, &pv->moves[i]);
+		printf(" %s", uci);
+	}
+	printf("\n");
+	fflush(stdout);
+	funlockfile(stdout);
+}
+
+void outputSearchStats(SearchStats* s) {
+	printf("Nodes: %" PRIu64, s->nodes);
+#ifdef COLLECT_STATS
+	printf(" (q %" PRIu64 ") seldepth: %d\n", s->qnodes, s->seldepth);
+	printf("TT probes: %" PRIu64 " hits: %" PRIu64 " stores: %" PRIu64 " overwrites: %" PRIu64 "\n",
+		s->ttProbes, s->ttHits, s->ttStores, s->ttOverwrites);
+	printf("Beta cutoffs: %" PRIu64 " (%.1f%% on first move)", s->betaCutoffs,
+		(s->betaCutoffs > 0) ? 100.0 * s->firstMoveCutoffs / s->betaCutoffs : 0.0);
+#endif
+	printf("\n");
+}
+
+// The node type to store for bestScore from a search of (alpha, beta): an
+// upper bound if it failed low, a lower bound if it failed high, else exact.
+// Scores are from white's point of view, so this holds for both sides
+static inline int boundType(int bestScore, int alpha, int beta, int exact, int upper, int lower) {
+	if(bestScore <= alpha) {
+		return upper;
+	}
+	if(bestScore >= beta) {
+		return lower;
+	}
+	return exact;
+}
+
+// checks is QS_CHECKS_OFF, or how many more plies, this one included, also
+// try quiet checks. With checks on, a side in check searches its evasions
+// rather than standing pat, so that the checks' mates are seen
+int quiescenceSearchHash(Position* p, IrrFlagStack* fs, HashTable* ht, int depthSearched, int depth, int alpha, int beta, int checks) {
+	// printf("quiescenceSearch, Depth=%d, alpha=%d, beta=%d\n", maxExtensions, alpha, beta);
+	SEARCH_STATS.nodes++;
+	STAT_INC(qnodes);
+	STAT_MAX(seldepth, fs->used - SEARCH_STATS.rootPly);
+	// TODO
+	if(depth == 0) {
+		return cachedEval(p);
+	}
+
+	int ply = searchPly(fs);
+	int score;
+	HashTableEntry* lookup = getFromHashTable(ht, p->hash);
+	STAT_INC(ttProbes);
+	// Entries hold the draft (plies left) they were searched with. Capture
+	// entries need at least this many; full width ones from
+	// iterativeDeepeningSearch went further than any capture search
+	if((lookup != NULL) && (lookup->key == p->hash) && (lookup->nodeType < PV_NODE_CAPTURES || (int) lookup->depth >= depth)) {
+		STAT_INC(ttHits);
+		// ALL nodes hold an upper bound, CUT nodes a lower one
+		score = scoreFromTT(lookup->score, ply);
+		switch(lookup->nodeType) {
+			case PV_NODE:
+			case PV_NODE_CAPTURES:
+				return score;
+			case ALL_NODE:
+			case ALL_NODE_CAPTURES:
+				beta = (beta < score) ? beta : score;
+				break;
+			case CUT_NODE:
+			case CUT_NODE_CAPTURES:
+				alpha = (alpha > score) ? alpha : score;
+				break;
+		}
+		if(alpha >= beta) {
+			return score;
+		}
+	}
+	// The window actually searched, for the bound stored at the end
+	int alphaOrig = alpha, betaOrig = beta;
+
+	// Standing pat is a move too, so it bounds the score from the side to
+	// move's end
+	int inCheck = (checks != QS_CHECKS_OFF) && getCheckers(p);
+	int standPat = 0;
+	if(!inCheck) {
+		standPat = cachedEval(p);
+		if(p->player == WHITE) {
+			if(standPat >= beta) {
+				return standPat;
+			}
+			alpha = (alpha > standPat) ? alpha : standPat;
+		} else {
+			if(standPat <= alpha) {
+				return standPat;
+			}
+			beta = (beta < standPat) ? beta : standPat;
+		}
+	}
+
+	MoveList ml;
+	if(inCheck) {
+		genLegalMoves(&ml, p, fs);
+	} else if(checks > 0) {
+		genCapturesAndChecks(&ml, p, fs);
+	} else {
+		genCaptures(&ml, p, fs);
+	}
+	// outputPosition(p);
+	// outputMoveList(&ml, '\n', TRUE);
+	sortCapturesMVVLVA(&ml);
+	// outputMoveList(&ml, '\n', TRUE);
+	int numMoves = ml.used;
+	if(numMoves == 0) {
+		freeMoveList(&ml);
+		if(inCheck) {
+			// Checkmated
+			return matedScore(p->player, ply);
+		}
+		// return heuristicEval(p);
+		return standPat;
+	}
+	int bestScore, eval;
+	Move* m;
+	Move bestMove = ml.list[0];
+	// int bestIndex = 0;
+	if(p->player == WHITE) {
+		// Maximising player
+		bestScore = inCheck ? INT_MIN : standPat;
+		for(int i=0; i<numMoves; i++) {
+			m = &ml.list[i];
+			prefetchHashTable(ht, hashAfterMove(p, m));
+			makeMove(p, m, fs);
+			eval = quiescenceSearchHash(p, fs, ht, depthSearched, depth - 1, alpha, beta, (checks > 0) ? checks - 1 : checks);
+			unmakeMove(p, m, fs);
+			if(eval > bestScore) {
+				bestMove = *m;
+			}
+			bestScore = (bestScore > eval) ? bestScore : eval;
+			alpha = (alpha > bestScore) ? alpha : bestScore;
+			if(alpha >= beta) {
+				STAT_INC(betaCutoffs);
+				if(i == 0) {
+					STAT_INC(firstMoveCutoffs);
+				}
+				addToHashTable(ht, p->hash, *m, depth, scoreToTT(bestScore, ply), CUT_NODE_CAPTURES);
+				freeMoveList(&ml);
+				return bestScore;
+				// break;
+			}
+		}
+	} else {
+		// Minimising player
+		bestScore = inCheck ? INT_MAX : standPat;
+		for(int i=0; i<numMoves; i++) {
+			m =  &ml.list[i];
+			prefetchHashTable(ht, hashAfterMove(p, m));
+			makeMove(p, m, fs);
+			// verifyHash(p, m, 2);
+			eval = quiescenceSearchHash(p, fs, ht, depthSearched, depth - 1, alpha, beta, (checks > 0) ? checks - 1 : checks);
+			unmakeMove(p, m, fs);
+			// verifyHash(p, m, 3);
+			if(eval < bestScore) {
+				bestMove = *m;
+			}
+			bestScore = (bestScore < eval) ? bestScore : eval;
+			beta = (beta < bestScore) ? beta : bestScore;
+			if(beta <= alpha) {
+				STAT_INC(betaCutoffs);
+				if(i == 0) {
+					STAT_INC(firstMoveCutoffs);
+				}
+				addToHashTable(ht, p->hash, *m, depth, scoreToTT(bestScore, ply), ALL_NODE_CAPTURES);
+				freeMoveList(&ml);
+				return bestScore;
+				// break;
+			}
+		}
+	}
+	// printf("Returning: %d", bestScore);
+	freeMoveList(&ml);
+
+	addToHashTable(ht, p->hash, bestMove, depth, scoreToTT(bestScore, ply),
+		boundType(bestScore, alphaOrig, betaOrig, PV_NODE_CAPTURES, ALL_NODE_CAPTURES, CUT_NODE_CAPTURES));
+	return bestScore;
+}
+
+int iterativeDeepeningSearch(Position* p, IrrFlagStack* fs, HashTable* ht, int depthSearched, int depth, int maxExtensions, int quiescenceChecks, int alpha, int beta, int capture) {
+	int bestScore, eval, lowest, highest;
+	int ply = searchPly(fs);
+	SEARCH_STATS.nodes++;
+	STAT_MAX(seldepth, ply);
+	if(ply < PV_MAX_PLY) {
+		PV_LENGTH[ply] = 0;
+	}
+	// The result is thrown away, and nothing more is stored in the TT
+	if(searchStopped()) {
+		return 0;
+	}
+
+	// Mate distance pruning. The side to move can't do better than mating
+	// on the next ply, or worse than being mated here, so once a shorter
+	// mate has been found elsewhere this node can't matter
+	lowest = (p->player == WHITE) ? matedScore(WHITE, ply) : matedScore(WHITE, ply + 1);
+	highest = (p->player == WHITE) ? matedScore(BLACK, ply + 1) : matedScore(BLACK, ply);
+	if(lowest >= beta) {
+		return lowest;
+	}
+	if(highest <= alpha) {
+		return highest;
+	}
+	alpha = (alpha > lowest) ? alpha : lowest;
+	beta = (beta < highest) ? beta : highest;
+
+	HashTableEntry* lookup = getFromHashTable(ht, p->hash);
+	STAT_INC(ttProbes);
+	// Only entries searched with at least this draft (plies left) will do
+	if((lookup != NULL) && (lookup->key == p->hash) && (int) lookup->depth >= depth) {
+		STAT_INC(ttHits);
+		// ALL nodes hold an upper bound, CUT nodes a lower one
+		eval = scoreFromTT(lookup->score, ply);
+		switch(lookup->nodeType) {
+			case PV_NODE:
+				return eval;
+			case ALL_NODE:
+				beta = (beta < eval) ? beta : eval;
+				if(alpha >= beta) {
+					return eval;
+				}
+				break;
+			case CUT_NODE:
+				alpha = (alpha > eval) ? alpha : eval;
+				if(alpha >= beta) {
+					return eval;
+				}
+				break;
+			// case PV_NODE_CAPTURES:
+			// 	refutation = lookup->move;
+			// 	makeMove(p, &refutation, fs);
+			// 	// verifyHash(p, m, 0);
+			// 	eval = iterativeDeepeningSearch(p, fs, ht, depthSearched + 1, depth - 1, maxExtensions, alpha, beta, refutation.cPiece);
+			// 	unmakeMove(p, &refutation, fs);
+			// 	switch(p->player) {
+			// 		case WHITE:
+			// 			if(eval >= beta) {
+			// 				return eval;
+			// 			}
+			// 			break;
+			// 		case BLACK:
+			// 			if(eval <= alpha) {
+			// 				return eval;
+			// 			}
+			// 			break;
+			// 	}
+		}
+	}
+	// The window actually searched, for the bound stored at the end
+	int alphaOrig = alpha, betaOrig = beta;
+
+	if(depth == 0) {
+		switch(capture) {
+			case 0:
+				return cachedEval(p);
+			default:
+				return quiescenceSearchHash(p, fs, ht, depthSearched, maxExtensions, alpha, beta, quiescenceChecks ? QS_CHECK_PLIES : QS_CHECKS_OFF);
+		}
+	}
+
+	MoveList ml;
+	genLegalMoves(&ml, p, fs);
+	sortCapturesMVV(&ml);
+	int numMoves = ml.used;
+	if(numMoves == 0) {
+		freeMoveList(&ml);
+		switch(scoreFinalPosition(p)) {
+			case RES_WHITE_WIN:
+				return matedScore(BLACK, ply);
+			case RES_BLACK_WIN:
+				return matedScore(WHITE, ply);
+			default:
+				return 0;
+		}
+	}
+	Move* m;
+	Move bestMove = ml.list[0];
+	// int bestIndex = 0;
+	if(p->player == WHITE) {
+		// Maximising player
+		bestScore = INT_MIN;
+		for(int i=0; i<numMoves; i++) {
+			m = &ml.list[i];
+			prefetchHashTable(ht, hashAfterMove(p, m));
+			makeMove(p, m, fs);
+			// verifyHash(p, m, 0);
+			eval = iterativeDeepeningSearch(p, fs, ht, depthSearched + 1, depth - 1, maxExtensions, quiescenceChecks, alpha, beta, m->cPiece);
+			unmakeMove(p, m, fs);
+			if(SEARCH_STOPPED) {
+				freeMoveList(&ml);
+				return 0;
+			}
+			// verifyHash(p, m, 1);
+			if(eval > bestScore) {
+				bestMove = *m;
+				updatePv(ply, m);
+			}
+			bestScore = (bestScore > eval) ? bestScore : eval;
+			alpha = (alpha > bestScore) ? alpha : bestScore;
+			if(alpha >= beta) {
+				// beta cutoff
+				STAT_INC(betaCutoffs);
+				if(i == 0) {
+					STAT_INC(firstMoveCutoffs);
+				}
+				addToHashTable(ht, p->hash, *m, depth, scoreToTT(bestScore, ply), CUT_NODE);
+				freeMoveList(&ml);
+				return bestScore;
+				// break;
+			}
+		}
+	} else {
+		// Minimising player
+		bestScore = INT_MAX;
+		for(int i=0; i<numMoves; i++) {
+			m =  &ml.list[i];
+			prefetchHashTable(ht, hashAfterMove(p, m));
+			makeMove(p, m, fs);
+			eval = iterativeDeepeningSearch(p, fs, ht, depthSearched + 1, depth - 1, maxExtensions, quiescenceChecks, alpha, beta, m->cPiece);
+			unmakeMove(p, m, fs);
+			if(SEARCH_STOPPED) {
+				freeMoveList(&ml);
+				return 0;
+			}
+			if(eval < bestScore) {
+				bestMove = *m;
+				updatePv(ply, m);
+			}
+			bestScore = (bestScore < eval) ? bestScore : eval;
+			beta = (beta < bestScore) ? beta : bestScore;
+			if(beta <= alpha) {
+				STAT_INC(betaCutoffs);
+				if(i == 0) {
+					STAT_INC(firstMoveCutoffs);
+				}
+				addToHashTable(ht, p->hash, *m, depth, scoreToTT(bestScore, ply), ALL_NODE);
+				freeMoveList(&ml);
+				return bestScore;
+				// break;
+			}
+		}
+	}
+	// printf("Returning: %d", bestScore);
+	freeMoveList(&ml);
+
+	addToHashTable(ht, p->hash, bestMove, depth, scoreToTT(bestScore, ply),
+		boundType(bestScore, alphaOrig, betaOrig, PV_NODE, ALL_NODE, CUT_NODE));
+	return bestScore;
+
+
+}
+
+// Whether score is a mate found within the full width of a depth iteration,
+// so deeper iterations can't find a shorter one
+static inline int mateProven(int score, int depth) {
+	int distance = MATE_SCORE - ((score < 0) ? -score : score);
+	return distance <= MAX_PLY && distance <= depth + 1;
+}
+
+static uint64_t elapsedMs(struct timespec* start) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)(now.tv_sec - start->tv_sec) * 1000 + (now.tv_nsec - start->tv_nsec) / 1000000;
+}
+
+// Alpha-beta over the root moves from index first on, from white's point of
+// view like the rest of the search. The best move's index goes in best and
+// its line in pv
+static int searchRootMoves(Position* p, IrrFlagStack* fs, HashTable* ht, MoveList* rootMoves, int first, int depth, int maxExtensions, int quiescenceChecks, int alpha, int beta, int* best, PvLine* pv) {
+	int i, eval;
+	int bestScore = (p->player == WHITE) ? INT_MIN : INT_MAX;
+	Move m;
+	*best = first;
+	pv->length = 0;
+	for(i=first; i<rootMoves->used; i++) {
+		m = rootMoves->list[i];
+		prefetchHashTable(ht, hashAfterMove(p, &m));
+		makeMove(p, &m, fs);
+		eval = iterativeDeepeningSearch(p, fs, ht, 0, depth, maxExtensions, quiescenceChecks, alpha, beta, m.cPiece);
+		unmakeMove(p, &m, fs);
+		if(SEARCH_STOPPED) {
+			break;
+		}
+		if((p->player == WHITE) ? (eval > bestScore) : (eval < bestScore)) {
+			bestScore = eval;
+			*best = i;
+			pv->moves[0] = m;
+			pv->length = 1 + PV_LENGTH[1];
+			memcpy(&pv->moves[1], PV_TABLE[1], PV_LENGTH[1] * sizeof(Move));
+		}
+		if(p->player == WHITE) {
+			alpha = (alpha > bestScore) ? alpha : bestScore;
+		} else {
+			beta = (beta < bestScore) ? beta : bestScore;
+		}
+		if(alpha >= beta) {
+			break;
+		}
+	}
+	return bestScore;
+}
+
+// Searches multiPV lines in turn. Each is the best of the root moves not
+// already taken by an earlier line, and is moved up to its place in the
+// list, so the moves before it are excluded and the next iteration tries
+// the lines first. From ASPIRATION_DEPTH on each line is searched in an
+// aspiration window around its last score.
+// callback, if not NULL, is given the best move after each iteration.
+// quiescenceChecks adds quiet checks to quiescence's first ply. control, if
+// not NULL, lets another thread stop the search or hold it past maxDepth.
+// An iteration cut short is thrown away, so the move returned, and
+// SEARCH_PV, are from the last one completed
+Move iterativeDeepeningAI(Position* p, IrrFlagStack* fs, HashTable* ht, int maxDepth, int maxExtensions, int quiescenceChecks, int multiPV, int verbose, IterationCallback callback, void* data, SearchControl* control) {
+
+	int depth, numMoves, lines, line, i, best, score, delta, alpha, beta, proven;
+	struct timespec start;
+	Move m, completed;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	refreshEvaluator(p->evaluator, p);
+	resetSearchStats(&SEARCH_STATS);
+	SEARCH_STATS.rootPly = fs->used;
+	SEARCH_CONTROL = control;
+	SEARCH_STOPPED = FALSE;
+	SEARCH_POLL_COUNTDOWN = SEARCH_POLL_NODES;
+	SEARCH_MAX_DEPTH = maxDepth;
+	SEARCH_PV.length = 0;
+
+	MoveList rootMoves;
+	genLegalMoves(&rootMoves, p, fs);
+	sortCapturesMVV(&rootMoves);
+	numMoves = rootMoves.used;
+	lines = (multiPV > 1) ? multiPV : 1;
+	lines = (lines < numMoves) ? lines : numMoves;
+	// The best move of the last complete iteration. A stopped one reorders
+	// rootMoves before being thrown away
+	completed = (numMoves > 0) ? rootMoves.list[0] : (Move) {0};
+
+	// Scores are from white's point of view
+	int lineScores[lines > 0 ? lines : 1];
+	PvLine pvs[lines > 0 ? lines : 1];
+
+	for(depth = 0; lines > 0; depth++) {
+		if(depth > maxDepth && (control == NULL || !atomic_load(&control->infinite) || depth > INFINITE_MAX_DEPTH)) {
+			break;
+		}
+		SEARCH_ITERATION = depth;
+		for(line=0; line<lines; line++) {
+			delta = ASPIRATION_WINDOW;
+			if(depth >= ASPIRATION_DEPTH && lineScores[line] > -MATE_BOUND && lineScores[line] < MATE_BOUND) {
+				alpha = lineScores[line] - delta;
+				beta = lineScores[line] + delta;
+			} else {
+				alpha = INT_MIN;
+				beta = INT_MAX;
+			}
+			while(TRUE) {
+				score = searchRootMoves(p, fs, ht, &rootMoves, line, depth, maxExtensions, quiescenceChecks, alpha, beta, &best, &pvs[line]);
+				delta *= 4;
+				if(SEARCH_STOPPED) {
+					break;
+				} else if(score <= alpha && alpha != INT_MIN) {
+					alpha = (delta > ASPIRATION_MAX) ? INT_MIN : score - delta;
+				} else if(score >= beta && beta != INT_MAX) {
+					beta = (delta > ASPIRATION_MAX) ? INT_MAX : score + delta;
+				} else {
+					break;
+				}
+			}
+			if(SEARCH_STOPPED) {
+				break;
+			}
+			lineScores[line] = score;
+			m = rootMoves.list[best];
+			for(i=best; i>line; i--) {
+				rootMoves.list[i] = rootMoves.list[i - 1];
+			}
+			rootMoves.list[line] = m;
+		}
+		if(SEARCH_STOPPED) {
+			break;
+		}
+		SEARCH_PV = pvs[0];
+		completed = rootMoves.list[0];
+
+		if(verbose) {
+			for(line=0; line<lines; line++) {
+				score = (p->player == WHITE) ? lineScores[line] : -lineScores[line];
+				outputSearchInfo(depth, (lines > 1) ? line + 1 : 0, score, SEARCH_STATS.nodes, elapsedMs(&start), &pvs[line]);
+			}
+#ifdef COLLECT_STATS
+			outputSearchStats(&SEARCH_STATS);
+#endif
+		}
+		if(callback != NULL) {
+			callback(depth, &rootMoves.list[0], lineScores[0], data);
+		}
+		proven = TRUE;
+		for(line=0; line<lines; line++) {
+			proven = proven && mateProven(lineScores[line], depth);
+		}
+		if(proven) {
+			break;
+		}
+	}
+
+	freeMoveList(&rootMoves);
+	return completed;
+}
@@ -0,0 +1,80 @@
+// tests: checks of engine behaviour that bench's node count can't show.
+// make test builds and runs them; the exit status is the number of failures
+#include "chess-b.h"
+
+int FAILURES = 0;
+
+#define CHECK(cond, ...) do { \
+	if(!(cond)) { \
+		printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+		printf(__VA_ARGS__); \
+		printf("\n"); \
+		FAILURES++; \
+	} \
+} while(0)
+
+// Away from the fifty move rule the evaluation is the unscaled one, as it
+// was before damping was limited to the rule's last plies. Near it, it
+// falls to a draw
+void testFiftyMoveScale(Evaluator* e) {
+	Position p;
+	int i, score;
+	for(i=0; i<BENCH_FEN_COUNT; i++) {
+		setupPositionFromFen(&p, BENCH_FENS[i], e);
+		score = staticEval(&p);
+		p.flag.plyCount = 0;
+		CHECK(heuristicEval(&p) == score, "%s: eval %d at ply 0, unscaled %d", BENCH_FENS[i], heuristicEval(&p), score);
+		p.flag.plyCount = FIFTY_MOVE_DAMPING_START;
+		CHECK(heuristicEval(&p) == score, "%s: eval %d at ply %d, unscaled %d", BENCH_FENS[i], heuristicEval(&p), FIFTY_MOVE_DAMPING_START, score);
+		p.flag.plyCount = FIFTY_MOVE_PLIES;
+		CHECK(heuristicEval(&p) == 0, "%s: eval %d at ply %d", BENCH_FENS[i], heuristicEval(&p), FIFTY_MOVE_PLIES);
+	}
+}
+
+// Evaluating a position mustn't change it. The attack maps left by
+// makeMove are stale for sliders, and stay so after eval
+void testEvalLeavesAttackMaps(Evaluator* e, IrrFlagStack* fs) {
+	Position p;
+	MoveList ml;
+	uint64_t attacks[64];
+	int i, j;
+	for(i=0; i<BENCH_FEN_COUNT; i++) {
+		setupPositionFromFen(&p, BENCH_FENS[i], e);
+		genLegalMoves(&ml, &p, fs);
+		for(j=0; j<ml.used; j++) {
+			makeMove(&p, &ml.list[j], fs);
+			memcpy(attacks, p.squareAttacksBB, sizeof(attacks));
+			heuristicEval(&p);
+			CHECK(memcmp(attacks, p.squareAttacksBB, sizeof(attacks)) == 0, "%s: eval changed the attack maps after move %d", BENCH_FENS[i], j);
+			unmakeMove(&p, &ml.list[j], fs);
+		}
+		freeMoveList(&ml);
+	}
+}
+
+// Castling rights are kept only while the king and that rook are at home
+void testFenCastlingRights(Evaluator* e) {
+	Position p;
+	setupPositionFromFen(&p, "r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1", e);
+	CHECK(p.flag.castlingFlags == (W_KSIDE_CASTLE | W_QSIDE_CASTLE | B_KSIDE_CASTLE | B_QSIDE_CASTLE), "all rights: flags %d", p.flag.castlingFlags);
+	setupPositionFromFen(&p, "r3k3/8/8/8/8/8/8/4K2R w KQkq - 0 1", e);
+	CHECK(p.flag.castlingFlags == (W_KSIDE_CASTLE | B_QSIDE_CASTLE), "missing rooks: flags %d", p.flag.castlingFlags);
+	setupPositionFromFen(&p, "r2k3r/8/8/8/8/8/8/R2K3R w KQkq - 0 1", e);
+	CHECK(p.flag.castlingFlags == 0, "kings moved: flags %d", p.flag.castlingFlags);
+}
+
+int main(void) {
+	Evaluator e;
+	IrrFlagStack fs;
+	initEvaluator(&e, EVAL_CACHE_DEFAULT_SIZE);
+	initIrrFlagStack(&fs, 64);
+
+	testFiftyMoveScale(&e);
+	testEvalLeavesAttackMaps(&e, &fs);
+	testFenCastlingRights(&e);
+
+	freeIrrFlagStack(&fs);
+	freeEvaluator(&e);
+	printf("%s (%d failures)\n", FAILURES ? "FAILED" : "OK", FAILURES);
+	return FAILURES;
+}
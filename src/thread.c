@@ -0,0 +1,79 @@
+// Searches on a background thread, for pondering and for UCI searches that
+// have to be stoppable
+#include "chess-b.h"
+
+static void* runSearchThread(void* arg) {
+	SearchThread* st = arg;
+	char uci[6];
+	struct timespec wait = {0, 1000000};
+
+	st->best = iterativeDeepeningAI(&st->position, &st->flagStack, st->hashTable, st->depth, st->maxExtensions,
+		st->quiescenceChecks, st->multiPV, st->uciOutput, NULL, NULL, &st->control);
+	st->pv = SEARCH_PV;
+
+	if(st->uciOutput) {
+		// UCI doesn't allow a bestmove while pondering or in go infinite, even
+		// if the search is over
+		while(atomic_load(&st->control.infinite) && !atomic_load(&st->control.stop)) {
+			nanosleep(&wait, NULL);
+		}
+		flockfile(stdout);
+		moveToUci(uci, &st->best);
+		printf("bestmove %s", uci);
+		if(st->pv.length >= 2) {
+			moveToUci(uci, &st->pv.moves[1]);
+			printf(" ponder %s", uci);
+		}
+		printf("\n");
+		fflush(stdout);
+		funlockfile(stdout);
+	}
+	return NULL;
+}
+
+// Searches p (which must have a legal move) on a new thread, evaluating with
+// e. e and ht belong to the search until it's joined. infinite holds it past
+// depth until ponderHit or stopSearchThread. With uciOutput it prints info
+// lines as it goes and bestmove at the end
+void startSearchThread(SearchThread* st, Position* p, IrrFlagStack* fs, Evaluator* e, HashTable* ht, int depth, int maxExtensions, int quiescenceChecks, int multiPV, int infinite, int uciOutput) {
+	st->position = *p;
+	st->position.evaluator = e;
+	initIrrFlagStack(&st->flagStack, fs->size);
+	memcpy(st->flagStack.list, fs->list, fs->used * sizeof(IrrFlag));
+	st->flagStack.used = fs->used;
+	st->hashTable = ht;
+	st->depth = depth;
+	st->maxExtensions = maxExtensions;
+	st->quiescenceChecks = quiescenceChecks;
+	st->multiPV = multiPV;
+	st->uciOutput = uciOutput;
+	atomic_store(&st->control.stop, FALSE);
+	atomic_store(&st->control.infinite, infinite);
+	st->pv.length = 0;
+
+	if(pthread_create(&st->thread, NULL, runSearchThread, st) != 0) {
+		printf("ERROR: PTHREAD_CREATE FAILED\n");
+		freeIrrFlagStack(&st->flagStack);
+		st->running = FALSE;
+		return;
+	}
+	st->running = TRUE;
+}
+
+// The expected move was played, so the search becomes a normal one, ending at
+// its depth. If it's already deeper it stops, keeping what it has
+void ponderHit(SearchThread* st) {
+	atomic_store(&st->control.infinite, FALSE);
+}
+
+void stopSearchThread(SearchThread* st) {
+	atomic_store(&st->control.stop, TRUE);
+}
+
+// Waits for the search to end, returning its best move. Its line is in st->pv
+Move joinSearchThread(SearchThread* st) {
+	pthread_join(st->thread, NULL);
+	freeIrrFlagStack(&st->flagStack);
+	st->running = FALSE;
+	return st->best;
+}
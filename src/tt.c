@@ -0,0 +1,276 @@
+// Transposition table
+#include "chess-b.h"
+
+unsigned int calcHash(unsigned int hash32) {
+	return hash32 % HASH_TABLE_SIZE;
+}
+
+typedef struct {
+	HashTableEntry* array;
+	int start;
+	int end;
+} HashClearRange;
+
+static void* clearHashRange(void* arg) {
+	HashClearRange* range = arg;
+	int i;
+	HashTableEntry empty;
+	memset(&empty, 0, sizeof(empty));
+	empty.nodeType = EMPTY;
+	for(i=range->start; i<range->end; i++) {
+		range->array[i] = empty;
+	}
+	return NULL;
+}
+
+// Clears on up to one thread per CPU, each taking a contiguous slice. As
+// each thread is first to touch its slice, on NUMA hosts the kernel places
+// those pages on that thread's node, spreading the table out rather than
+// putting it all on the node of the thread that allocated it
+void clearHashTable(HashTable* ht) {
+	pthread_t threads[HASH_CLEAR_MAX_THREADS];
+	HashClearRange ranges[HASH_CLEAR_MAX_THREADS];
+	int started[HASH_CLEAR_MAX_THREADS];
+	long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	int i, n = HASH_TABLE_SIZE / HASH_CLEAR_MIN_ENTRIES;
+
+	if(n > cpus) {
+		n = cpus;
+	}
+	if(n > HASH_CLEAR_MAX_THREADS) {
+		n = HASH_CLEAR_MAX_THREADS;
+	}
+	if(n < 1) {
+		n = 1;
+	}
+	for(i=0; i<n; i++) {
+		ranges[i].array = ht->array;
+		ranges[i].start = (int) ((int64_t) HASH_TABLE_SIZE * i / n);
+		ranges[i].end = (int) ((int64_t) HASH_TABLE_SIZE * (i + 1) / n);
+	}
+	// This thread takes the first slice, and any whose thread didn't start
+	for(i=1; i<n; i++) {
+		started[i] = (pthread_create(&threads[i], NULL, clearHashRange, &ranges[i]) == 0);
+	}
+	clearHashRange(&ranges[0]);
+	for(i=1; i<n; i++) {
+		if(started[i]) {
+			pthread_join(threads[i], NULL);
+		} else {
+			clearHashRange(&ranges[i]);
+		}
+	}
+}
+
+// An anonymous mapping of size bytes, a multiple of HUGE_PAGE_SIZE, aligned
+// to HUGE_PAGE_SIZE so that the kernel can back all of it with huge pages.
+// Trims an oversized mapping rather than relying on mmap's alignment
+static void* mapAligned(size_t size) {
+	char* base = mmap(NULL, size + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	char* aligned;
+	if(base == MAP_FAILED) {
+		return NULL;
+	}
+	aligned = (char*) (((uintptr_t) base + HUGE_PAGE_SIZE - 1) & ~(uintptr_t) (HUGE_PAGE_SIZE - 1));
+	if(aligned > base) {
+		munmap(base, aligned - base);
+	}
+	munmap(aligned + size, base + HUGE_PAGE_SIZE - aligned);
+	return aligned;
+}
+
+// Whether the kernel actually backed the mapping holding addr with huge
+// pages, from its AnonHugePages in /proc/self/smaps. madvise succeeds even
+// when transparent huge pages are disabled, so it can't tell
+static int backedByHugePages(void* addr) {
+	FILE* f = fopen("/proc/self/smaps", "r");
+	char line[256];
+	uintptr_t start, end, a = (uintptr_t) addr;
+	unsigned long kb;
+	int inMapping = FALSE, backed = FALSE;
+	if(f == NULL) {
+		return FALSE;
+	}
+	while(fgets(line, sizeof(line), f) != NULL) {
+		// Each mapping starts with a start-end line, then its fields
+		if(sscanf(line, "%" SCNxPTR "-%" SCNxPTR, &start, &end) == 2) {
+			inMapping = (a >= start && a < end);
+		} else if(inMapping && sscanf(line, "AnonHugePages: %lu", &kb) == 1) {
+			backed = (kb > 0);
+			break;
+		}
+	}
+	fclose(f);
+	return backed;
+}
+
+// With hugePages, prefers explicit huge pages (needs a reserved pool, see
+// /proc/sys/vm/nr_hugepages), then transparent huge pages, then malloc.
+// Huge pages cut TLB misses on probes, which are all over the table
+void initHashTable(HashTable* ht, int hugePages) {
+	size_t size = HASH_TABLE_SIZE * sizeof(HashTableEntry);
+	size_t hugeSize = (size + HUGE_PAGE_SIZE - 1) & ~(size_t) (HUGE_PAGE_SIZE - 1);
+	void* mem = NULL;
+
+	ht->mapping = NULL;
+	ht->memory = HASH_MEMORY_MALLOC;
+#ifdef MAP_HUGETLB
+	if(hugePages) {
+		mem = mmap(NULL, hugeSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		if(mem != MAP_FAILED) {
+			ht->memory = HASH_MEMORY_HUGETLB;
+		} else {
+			mem = NULL;
+		}
+	}
+#endif
+#ifdef MADV_HUGEPAGE
+	if(hugePages && mem == NULL) {
+		mem = mapAligned(hugeSize);
+		if(mem != NULL && madvise(mem, hugeSize, MADV_HUGEPAGE) == 0) {
+			ht->memory = HASH_MEMORY_THP;
+		} else if(mem != NULL) {
+			munmap(mem, hugeSize);
+			mem = NULL;
+		}
+	}
+#endif
+	if(mem != NULL) {
+		ht->mapping = mem;
+		ht->mappingSize = hugeSize;
+		ht->array = mem;
+	} else {
+		ht->array = malloc(size);
+		if(ht->array == NULL) {
+			printf("ERROR: MALLOC FAILED\n"); return;
+		}
+	}
+	clearHashTable(ht);
+	// Only known once the clear has touched the pages
+	if(ht->memory == HASH_MEMORY_THP && !backedByHugePages(ht->array)) {
+		ht->memory = HASH_MEMORY_THP_REQUESTED;
+	}
+}
+
+const char* hashTableMemory(HashTable* ht) {
+	switch(ht->memory) {
+		case HASH_MEMORY_HUGETLB:
+			return "huge pages (MAP_HUGETLB)";
+		case HASH_MEMORY_THP:
+			return "transparent huge pages (madvise)";
+		case HASH_MEMORY_THP_REQUESTED:
+			return "transparent huge pages requested, not obtained";
+		case HASH_MEMORY_FILE:
+			return "file mapping";
+		default:
+			return "normal pages (malloc)";
+	}
+}
+
+// FNV-1a of the Zobrist keys. Entries are only meaningful to builds that
+// hash positions the same way
+static uint32_t hashKeyScheme(void) {
+	uint32_t h = 2166136261u;
+	int i;
+	for(i=0; i<ZOBRIST_LENGTH; i++) {
+		h = (h ^ ZOBRIST_RANDOMS[i]) * 16777619u;
+	}
+	return h;
+}
+
+// Backs the table with a shared mapping of path, so that it survives the
+// process for later runs. Entries are plain struct copies that two writers
+// could tear, so the file is locked (flock) to one process at a time, and
+// a file already in use is refused. A new or empty file is set up
+// with a header and empty entries; an existing one must match this build's
+// key scheme and table size. Returns FALSE (with ht unset) on error
+int mapHashTable(HashTable* ht, const char* path) {
+	struct stat st;
+	HashTableFileHeader* header;
+	size_t size = sizeof(HashTableFileHeader) + HASH_TABLE_SIZE * sizeof(HashTableEntry);
+	int fresh;
+
+	int fd = open(path, O_RDWR | O_CREAT, 0644);
+	if(fd < 0) {
+		printf("ERROR: CANNOT OPEN HASH FILE %s\n", path); return FALSE;
+	}
+	// Held until freeHashTable closes fd
+	if(flock(fd, LOCK_EX | LOCK_NB) != 0) {
+		printf("ERROR: HASH FILE %s IS IN USE\n", path);
+		close(fd); return FALSE;
+	}
+	if(fstat(fd, &st) != 0) {
+		printf("ERROR: CANNOT STAT HASH FILE %s\n", path);
+		close(fd); return FALSE;
+	}
+	fresh = (st.st_size == 0);
+	if(fresh && ftruncate(fd, size) != 0) {
+		printf("ERROR: CANNOT RESIZE HASH FILE %s\n", path);
+		close(fd); return FALSE;
+	}
+	if(!fresh && (size_t) st.st_size != size) {
+		printf("ERROR: HASH FILE %s HAS WRONG SIZE\n", path);
+		close(fd); return FALSE;
+	}
+	ht->mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if(ht->mapping == MAP_FAILED) {
+		printf("ERROR: MMAP FAILED\n");
+		close(fd);
+		ht->mapping = NULL; return FALSE;
+	}
+	ht->fd = fd;
+	ht->mappingSize = size;
+	ht->memory = HASH_MEMORY_FILE;
+	ht->array = (HashTableEntry*) ((char*) ht->mapping + sizeof(HashTableFileHeader));
+
+	header = (HashTableFileHeader*) ht->mapping;
+	if(fresh) {
+		memcpy(header->magic, "CCTT", 4);
+		header->version = HASH_FILE_VERSION;
+		header->keyScheme = hashKeyScheme();
+		header->entries = HASH_TABLE_SIZE;
+		header->entrySize = sizeof(HashTableEntry);
+		clearHashTable(ht);
+	} else if(memcmp(header->magic, "CCTT", 4) != 0 || header->version != HASH_FILE_VERSION
+		|| header->keyScheme != hashKeyScheme() || header->entries != (uint32_t) HASH_TABLE_SIZE
+		|| header->entrySize != sizeof(HashTableEntry)) {
+		printf("ERROR: HASH FILE %s HAS WRONG FORMAT\n", path);
+		munmap(ht->mapping, size);
+		close(fd);
+		ht->mapping = NULL; return FALSE;
+	}
+	return TRUE;
+}
+
+void addToHashTable(HashTable* ht, unsigned int key, Move m, int depth, int score, int nodeType) {
+	HashTableEntry e = ht->array[calcHash(key)];
+	STAT_INC(ttStores);
+	if(e.nodeType != EMPTY && e.key != key) {
+		STAT_INC(ttOverwrites);
+	}
+	if((e.nodeType = EMPTY) || (nodeType < e.nodeType) || (nodeType == e.nodeType && depth >= e.depth)) {
+		e.key = key;
+		e.move = m;
+		e.depth = depth;
+		e.score = score;
+		e.nodeType = nodeType;
+		ht->array[calcHash(key)] = e;
+	}
+}
+
+HashTableEntry* getFromHashTable(HashTable* ht, unsigned int key) {
+	return &ht->array[calcHash(key)];
+}
+
+// A file-backed table's entries are written back to its file by the kernel
+void freeHashTable(HashTable* ht) {
+	if(ht->mapping != NULL) {
+		munmap(ht->mapping, ht->mappingSize);
+		ht->mapping = NULL;
+		if(ht->memory == HASH_MEMORY_FILE) {
+			close(ht->fd);
+		}
+	} else {
+		free(ht->array);
+	}
+}
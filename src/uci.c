@@ -0,0 +1,171 @@
+// uci: Universal Chess Interface front end, for GUIs and analysis tools
+#include "chess-b.h"
+
+// Searches are to a fixed depth, as there's no time management. go depth N
+// overrides it
+#define UCI_DEFAULT_DEPTH 4
+#define UCI_DEFAULT_EXTENSIONS 12
+#define UCI_MAX_MULTIPV 256
+// Long enough for a position command with a few hundred moves
+#define UCI_MAX_LINE 16384
+
+typedef struct {
+	Position position;
+	IrrFlagStack flagStack;
+	HashTable hashTable;
+	Evaluator* evaluator;
+	int multiPV;
+	int quiescenceChecks;
+	SearchThread search;
+} UciState;
+
+// Ends the search if one is running. Its bestmove is printed as usual
+void uciStop(UciState* uci) {
+	if(uci->search.running) {
+		stopSearchThread(&uci->search);
+		joinSearchThread(&uci->search);
+	}
+}
+
+// Empties the hash table for ucinewgame and the Clear Hash button, which
+// share the (multithreaded) clear. ucinewgame keeps a hash file, as carrying
+// analysis over is its point, so only Clear Hash sets keepFile FALSE
+void uciClearHash(UciState* uci, int keepFile) {
+	uciStop(uci);
+	if(!keepFile || uci->hashTable.memory != HASH_MEMORY_FILE) {
+		clearHashTable(&uci->hashTable);
+	}
+}
+
+// setoption name NAME [value VALUE]
+void uciSetOption(UciState* uci, char* args) {
+	char* name = strstr(args, "name ");
+	char* value = strstr(args, " value ");
+	int n;
+	if(name != NULL && strcasecmp(name + strlen("name "), "Clear Hash") == 0) {
+		uciClearHash(uci, FALSE);
+		return;
+	}
+	if(name == NULL || value == NULL) {
+		return;
+	}
+	name += strlen("name ");
+	value += strlen(" value ");
+	if(strncasecmp(name, "MultiPV ", strlen("MultiPV ")) == 0 && sscanf(value, "%d", &n) == 1) {
+		uci->multiPV = (n < 1) ? 1 : (n > UCI_MAX_MULTIPV) ? UCI_MAX_MULTIPV : n;
+	}
+}
+
+// position [startpos | fen FEN] [moves MOVE...]. Moves stop at the first
+// illegal one
+void uciPosition(UciState* uci, char* args) {
+	char* moves = strstr(args, "moves");
+	char token[6];
+	Move m;
+	int n;
+
+	if(moves != NULL) {
+		*(moves - 1) = '\0';
+		moves += strlen("moves");
+	}
+	if(strncmp(args, "fen ", strlen("fen ")) == 0) {
+		if(!setupPositionFromFen(&uci->position, args + strlen("fen "), uci->evaluator)) {
+			printf("info string bad fen\n");
+			setupStartPosition(&uci->position, uci->evaluator);
+		}
+	} else {
+		setupStartPosition(&uci->position, uci->evaluator);
+	}
+
+	uci->flagStack.used = 0;
+	while(moves != NULL && sscanf(moves, " %5s%n", token, &n) == 1) {
+		moves += n;
+		if(!findUciMove(&uci->position, &uci->flagStack, token, &m)) {
+			printf("info string illegal move %s\n", token);
+			break;
+		}
+		makeMove(&uci->position, &m, &uci->flagStack);
+	}
+}
+
+// go [ponder] [infinite] [depth N], on a search thread so that stop and
+// ponderhit can be read meanwhile. Other limits are ignored. A ponder search
+// goes on past its depth until ponderhit, then finishes as a normal one
+void uciGo(UciState* uci, char* args) {
+	char* depthArg = strstr(args, "depth ");
+	int depth = UCI_DEFAULT_DEPTH;
+	int infinite = (strstr(args, "ponder") != NULL) || (strstr(args, "infinite") != NULL);
+	MoveList ml;
+
+	if(depthArg != NULL) {
+		sscanf(depthArg + strlen("depth "), "%d", &depth);
+	}
+	genLegalMoves(&ml, &uci->position, &uci->flagStack);
+	if(ml.used == 0) {
+		freeMoveList(&ml);
+		printf("bestmove 0000\n");
+		return;
+	}
+	freeMoveList(&ml);
+
+	startSearchThread(&uci->search, &uci->position, &uci->flagStack, uci->evaluator, &uci->hashTable, depth,
+		UCI_DEFAULT_EXTENSIONS, uci->quiescenceChecks, uci->multiPV, infinite, TRUE);
+}
+
+// Reads commands from stdin until quit or end of input
+// hashFile, if not NULL, backs the hash table so that analysis carries over
+// between runs
+void uciLoop(Evaluator* e, int quiescenceChecks, int hugePages, const char* hashFile) {
+	char line[UCI_MAX_LINE];
+	char* command;
+	UciState uci;
+
+	uci.evaluator = e;
+	uci.multiPV = 1;
+	uci.quiescenceChecks = quiescenceChecks;
+	uci.search.running = FALSE;
+	initIrrFlagStack(&uci.flagStack, 40);
+	if(hashFile == NULL || !mapHashTable(&uci.hashTable, hashFile)) {
+		initHashTable(&uci.hashTable, hugePages);
+	}
+	setupStartPosition(&uci.position, e);
+
+	while(fgets(line, sizeof(line), stdin) != NULL) {
+		line[strcspn(line, "\r\n")] = '\0';
+		command = line + strspn(line, " \t");
+
+		if(strcmp(command, "uci") == 0) {
+			printf("id name chess-b\n");
+			printf("id author C-Chess contributors\n");
+			printf("option name MultiPV type spin default 1 min 1 max %d\n", UCI_MAX_MULTIPV);
+			printf("option name Ponder type check default false\n");
+			printf("option name Clear Hash type button\n");
+			printf("uciok\n");
+		} else if(strcmp(command, "isready") == 0) {
+			printf("readyok\n");
+		} else if(strncmp(command, "setoption ", strlen("setoption ")) == 0) {
+			uciSetOption(&uci, command + strlen("setoption "));
+		} else if(strcmp(command, "ucinewgame") == 0) {
+			uciClearHash(&uci, TRUE);
+		} else if(strncmp(command, "position ", strlen("position ")) == 0) {
+			uciStop(&uci);
+			uciPosition(&uci, command + strlen("position "));
+		} else if(strncmp(command, "go", strlen("go")) == 0) {
+			uciStop(&uci);
+			uciGo(&uci, command + strlen("go"));
+		} else if(strcmp(command, "ponderhit") == 0) {
+			if(uci.search.running) {
+				ponderHit(&uci.search);
+			}
+		} else if(strcmp(command, "stop") == 0) {
+			uciStop(&uci);
+		} else if(strcmp(command, "quit") == 0) {
+			break;
+		}
+		fflush(stdout);
+	}
+
+	uciStop(&uci);
+	freeHashTable(&uci.hashTable);
+	freeIrrFlagStack(&uci.flagStack);
+}